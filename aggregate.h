@@ -0,0 +1,74 @@
+#ifndef AGGREGATE_H
+#define AGGREGATE_H
+
+#include <vector>
+#include "kernel.h"
+
+using namespace std;
+
+// define if debug output wanted
+//#define DEBUGAGG
+
+
+// least pages worth of memory the groups of a hash aggregation take,
+// if the memory governor grants no more; the rows of groups that do
+// not fit are spilled to partitions
+const int AGGMEMPAGES = 256;
+
+// partitions the rows of groups that do not fit are spread over
+const int AGGFANOUT = 8;
+
+// levels of partitioning, after which a partition is aggregated in a
+// table sized to hold all of its rows as groups
+const int AGGMAXDEPTH = 4;
+
+// offset of the grouping key in an entry of the table, after its hash
+const int AGGKEYOFF = 8;
+
+
+// An attribute of the grouping key: its place in the key and the
+// kernels that compare and hash it, so that strings are equal as they
+// are for strncmp, whatever follows their null.
+
+struct AggKeyAttr
+{
+  int off;                              // offset in the key
+  int len;                              // length of the attribute
+  AttrCmpFn cmp;
+  AttrHashFn hash;
+};
+
+
+// AggTable holds the groups of a hash aggregation, one fixed length
+// entry per group: the hash of the key, the key, and the running state
+// of each aggregate, updated in place.  Entries are appended to one
+// array; the slots of the open addressing table, which is at least
+// twice as large as the most entries the table may hold, are indexes
+// into it and are probed linearly.  Keys are compared attribute by
+// attribute.
+
+class AggTable
+{
+ public:
+  AggTable(const int entryLen, const int keyLen,
+	   const vector<AggKeyAttr> & keyAttrs, const int maxEntries);
+
+  // entry of the group with the given key, added with its key set if
+  // there is none; NULL if the group is new and the table is full
+  char *find(const char *key, const unsigned int hash, bool & isNew);
+
+  char *entry(const int i) { return &entries[(size_t) i * entryLen]; }
+  const int getCount() const { return cnt; }
+
+ private:
+  int entryLen;                         // bytes per entry, a multiple of 8
+  int keyLen;                           // bytes of the grouping key
+  vector<AggKeyAttr> keyAttrs;          // attributes of the key
+  int maxEntries;                       // groups the table may hold
+  int cnt;                              // groups it holds
+  unsigned int mask;                    // slots - 1, slots a power of 2
+  vector<int> slots;                    // entry numbers, -1 if empty
+  vector<char> entries;                 // the entries
+};
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include <string.h>
+#include <vector>
+#include "heapfile.h"
+
+using namespace std;
+
+
+// bits of Bloom filter per key added
+const int RFBITSPERKEY = 10;
+
+// bits set per key, all within one block of the filter
+const int RFHASHES = 7;
+
+// bits per block of the filter: one 64 byte cache line
+const int RFBLOCKBITS = 512;
+
+
+// A RuntimeFilter summarizes the join attribute values of one input
+// of a join, so that the other input can drop tuples without a
+// partner while it is scanned (see HeapFileScan::setRuntimeFilter).
+// Keys are collected with add() and the filter is built by build().
+// Integer keys spanning a range no larger than the Bloom filter would
+// be get an exact bitmap; everything else gets a blocked Bloom filter
+// in which all bits of a key fall into one cache line.
+//
+// The filter counts the tuples it is asked about and the tuples it
+// passes; the join reports how many of those actually had a partner,
+// from which print() derives the false positive rate.
+
+class RuntimeFilter {
+ public:
+  RuntimeFilter(const Datatype type,    // filter on values of an
+		const int length);    // attribute of this type
+  ~RuntimeFilter();
+
+  void add(const char *key);            // collect the key of a tuple
+  void build();                         // build filter from the keys
+  void clear();                         // drop keys, keep the counts
+
+  // false if no key added equals key.  Inline, as it is called for
+  // every tuple scanned.
+  bool mayContain(const char *key)
+  {
+    probed++;
+    bool found;
+    if (type == INTEGER)
+    {
+      int value;
+      memcpy(&value, key, sizeof(int));
+      if (value < minKey || value > maxKey) return false;
+      if (bitmap)
+      {
+	unsigned int bit = (unsigned int) value - (unsigned int) minKey;
+	found = (bits[bit >> 6] >> (bit & 63)) & 1;
+      }
+      else
+	found = probe(hashInt(value));
+    }
+    else
+      found = probe(hash(key));
+    if (found) passed++;
+    return found;
+  }
+
+  // account for tuples that passed and had a partner in the join
+  void matched(const int cnt) { trueMatches += cnt; }
+
+  // print one line summarizing the filter's effect
+  void print() const;
+
+ private:
+  typedef unsigned long long u64;
+
+  Datatype type;                        // type of the join attribute
+  int length;                           // length of the join attribute
+
+  vector<u64> keys;                     // keys or hashes added
+  int minKey, maxKey;                   // range of integer keys
+  int keyCnt;                           // keys added since construction
+
+  bool bitmap;                          // exact bitmap or Bloom filter
+  u64 *bits;                            // the filter
+  u64 blockCnt;                         // 512 bit blocks of a Bloom filter
+
+  double probed;                        // tuples asked about
+  double passed;                        // tuples passed
+  double trueMatches;                   // passed tuples with a partner
+
+  static u64 hashInt(const int value)
+  {
+    u64 z = (u64) (unsigned int) value * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  // hash of a float or string key.  Strings are null padded up to
+  // the attribute length, so hashing stops at the first null.
+  u64 hash(const char *key) const
+  {
+    if (type == FLOAT)
+    {
+      float value;
+      memcpy(&value, key, sizeof(float));
+      if (value == 0) value = 0;        // 0.0 == -0.0
+      unsigned int word;
+      memcpy(&word, &value, sizeof(word));
+      return hashInt((int) word);
+    }
+
+    u64 h = 0xCBF29CE484222325ULL;      // FNV-1a
+    for (int i = 0; i < length && key[i]; i++)
+      h = (h ^ (unsigned char) key[i]) * 0x100000001B3ULL;
+    return hashInt((int) (h ^ (h >> 32)));
+  }
+
+  // the block is chosen by the high half of h, the bits within it by
+  // 9 bit slices of the low half remixed
+  bool probe(const u64 h) const
+  {
+    const u64 *block = bits + ((h >> 32) % blockCnt) * (RFBLOCKBITS / 64);
+    u64 h2 = h * 0xC2B2AE3D27D4EB4FULL;
+    for (int i = 0; i < RFHASHES; i++)
+    {
+      unsigned int bit = (h2 >> (9 * i)) & (RFBLOCKBITS - 1);
+      if (!((block[bit >> 6] >> (bit & 63)) & 1)) return false;
+    }
+    return true;
+  }
+};
+
+#endif
@@ -1,6 +1,11 @@
 #ifndef BUF_H
 #define BUF_H
 
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
 #include "db.h"
 // define if debug output wanted
 //#define DEBUGBUF
@@ -43,6 +48,16 @@ public:
 
 
 class BufMgr;  //forward declaration of BufMgr class 
+struct FileBufStats;
+
+// the buffer pool lends the memory governor at most 1/LENDSHARE of
+// its frames
+const int LENDSHARE = 2;
+
+// frames ahead of the clock hand that the flusher keeps clean, unless
+// minirel is given CLEAN=<frames>, and most pages it writes at a time
+const int CLEANFRAMES = 16;
+const int FLUSHBATCH = 16;
 
 // class for maintaining information about buffer pool frames
 class BufDesc {
@@ -55,6 +70,11 @@ private:
   bool 	dirty;	  // true if dirty;  false otherwise
   bool 	valid;   // true if page is valid
   bool  refbit;	 // has this buffer frame been reference recently
+  bool  lent;	 // lent to the memory governor, out of the pool
+  bool  flushing; // being written back by the flusher
+  bool  io;	 // being read in, or written back to be replaced, with
+		 // the latch dropped
+  FileBufStats* stats; // counters of the file in the buffer pool stats
 
   void Clear() {  // initialize buffer frame for a new user
     	pinCnt = 0;
@@ -79,15 +99,52 @@ private:
 };
 
 
+// buffer pool counters of a single file
+struct FileBufStats
+{
+  int hits;        // accesses that found the page in the buffer pool
+  int misses;      // accesses that had to read the page from disk
+  int allocs;      // pages allocated
+  int writes;      // pages written back to disk
+
+  FileBufStats()
+    {
+      hits = misses = allocs = writes = 0;
+    }
+};
+
+
+#define SWEEPBUCKETS 8 // clock sweep histogram: 1, 2-3, 4-7, ... frames
+
 struct BufStats
 {
   int accesses;    // Total number of accesses to buffer pool
+  int lookups;     // hash table lookups of (file, page)
+  int hits;        // accesses that found the page in the buffer pool
+  int misses;      // accesses that had to read the page from disk
   int diskreads;   // Number of pages read from disk (including allocs)
   int diskwrites;  // Number of pages written back to disk
+  int bgWrites;    // of those, pages written by the flusher
+  int flushBatches; // batches of pages the flusher wrote
+  int allocs;      // Number of pages allocated
+  int cleanEvicts; // valid pages replaced without writing them
+  int dirtyEvicts; // valid pages written back before being replaced
+  int allocBufs;   // frames requested from the clock
+  int sweeps;      // frames looked at by the clock in total
+  int maxSweep;    // most frames looked at for a single request
+  int pinnedSkips; // frames passed over by the clock because pinned
+  int exceeded;    // requests failed because all frames were pinned
+  int sweepHist[SWEEPBUCKETS]; // frames looked at per request
+  map<string, FileBufStats> files; // counters by file name
 
   void clear()
     {
-      accesses = diskreads = diskwrites = 0;
+      accesses = lookups = hits = misses = diskreads = diskwrites = allocs = 0;
+      bgWrites = flushBatches = 0;
+      cleanEvicts = dirtyEvicts = 0;
+      allocBufs = sweeps = maxSweep = pinnedSkips = exceeded = 0;
+      memset(sweepHist, 0, sizeof(sweepHist));
+      files.clear();
     }
       
   BufStats()
@@ -97,17 +154,122 @@ struct BufStats
 };
 
 
+// the scalar counters of BufStats, for callers that take them before
+// and after an operation and do not want the counters of each file
+struct BufCounts
+{
+  int hits;        // accesses that found the page in the buffer pool
+  int misses;      // accesses that had to read the page from disk
+  int diskreads;   // pages read from disk (including allocs)
+  int diskwrites;  // pages written back to disk
+};
+
+
+// A PageHandle holds a pin on a page of the buffer pool.  It knows the
+// frame the page is in, so the pin is released, and the page marked
+// dirty if it was changed, without looking the page up again; that
+// happens when the handle goes away, is given another page by readPage
+// or allocPage, or is unpinned explicitly.  A handle cannot be copied
+// but can be moved, which hands the pin over to the new one.
+
+class PageHandle
+{
+  friend class BufMgr;
+public:
+  PageHandle() : mgr(NULL), frameNo(-1), page(NULL), dirty(false) {}
+  PageHandle(PageHandle && other);
+  PageHandle & operator=(PageHandle && other);
+  PageHandle(const PageHandle &) = delete;
+  PageHandle & operator=(const PageHandle &) = delete;
+  ~PageHandle() { (void) unpin(); }
+
+  Page*	get() const { return page; }	// the page, NULL if none pinned
+  Page*	operator->() const { return page; }
+  const bool pinned() const { return page != NULL; }
+
+  void  setDirty() { dirty = true; }	// page is written back when evicted
+
+  // releases the pin, if any, now
+  const Status unpin() { return page == NULL ? OK : release(); }
+
+private:
+  const Status release();
+  BufMgr*	mgr;		// buffer manager the page is pinned in
+  int		frameNo;	// frame of the page
+  Page*		page;		// the page, NULL if none pinned
+  bool		dirty;		// page was changed while pinned
+};
+
+
+// The buffer pool is shared by the sessions of a server, so each
+// method runs under the latch.  The latch is dropped while a page is
+// read into a frame or a dirty page written back to free its frame:
+// the frame is marked as having I/O in progress, which keeps the clock
+// and the flusher off it, and a session that wants the page, or wants
+// to dispose of it or flush its file, waits for ioDone.  Allocating and
+// disposing of pages update the file header under the latch.
+//
+// A buffer manager given clean frames runs a flusher thread, which
+// writes dirty unpinned pages back before the clock reaches them, so
+// that replacing a page seldom waits for a write.  It keeps that many
+// frames ahead of the clock hand clean, writing up to FLUSHBATCH
+// pages at a time in order of file and page number, and is woken as
+// the clock comes near a dirty page.  The pages are copied under the latch and
+// written without it; their frames are not replaced, and their pages
+// not disposed of or flushed with their file, until the write is done.
+
 class BufMgr 
 {
 private:
+  mutable mutex  latch;		// serializes the methods below
   unsigned int 	 clockHand;
   int   	 numBufs;    	// Number of pages in buffer pool
+  int		 lentBufs;	// frames lent to the memory governor
   BufHashTbl*    hashTable;  	// hash table mapping (File, page) to frame
   BufDesc*	 bufTable;  	// vector of status info, 1 per page
   BufStats	 bufStats;	// buffer pool statistics
 
-  const Status allocBuf(int & frame);   // allocate a free frame.  
+  int		 cleanFrames;	// frames the flusher keeps clean, or 0
+  int		 flushNext;	// frame of the first dirty page ahead of
+				// the clock it knows of, or -1
+  bool		 flushWake;	// the flusher has been woken
+  bool		 stopping;	// the flusher is to exit
+  condition_variable flushWanted; // wakes the flusher
+  condition_variable ioDone;	// signalled as a read or write of a
+				// frame, or a batch of the flusher, is done
+  thread	 flusher;
+  void flushAhead();		// body of the flusher
+
+  // frames the clock hand advances to reach frame
+  int ahead(const int frame) const
+  {
+	return (frame - (int) clockHand + numBufs) % numBufs;
+  }
+
+  // marks the page in a frame dirty, noting it for the flusher if it
+  // is the first dirty page ahead of the clock
+  void setDirty(const int frameNo)
+  {
+	bufTable[frameNo].dirty = true;
+	if (flushNext < 0 || ahead(frameNo) < ahead(flushNext))
+	    flushNext = frameNo;
+  }
+
+  // allocate a free frame; the latch, held by guard, is dropped while
+  // a dirty page is written back
+  const Status allocBuf(unique_lock<mutex> & guard, int & frame);
   const void releaseBuf(int frame); // return unused frame to end of list
+
+  // pin a page, reading it in if needed, and return its frame; and
+  // allocate a page and pin it.  The latch must be held by guard.
+  const Status pinPage(unique_lock<mutex> & guard, File* file,
+		       const int PageNo, int & frameNo);
+  const Status pinNewPage(unique_lock<mutex> & guard, File* file,
+			  int & PageNo, int & frameNo);
+
+  // unpin the page in a frame, for a PageHandle
+  friend class PageHandle;
+  const Status unPinFrame(const int frameNo, const bool dirty);
   void advanceClock()
   {
 	clockHand = (clockHand + 1) % numBufs;
@@ -117,24 +279,61 @@ private:
 public:
   Page*	         bufPool;   // actual buffer pool
 
-  BufMgr(const int bufs);
+  BufMgr(const int bufs, const int cleanFrames = 0);
   ~BufMgr();
 
   const Status readPage(File* file, const int PageNo, Page*& page);
   const Status unPinPage(File* file, const int PageNo, const bool dirty);
   const Status allocPage(File* file, int& PageNo, Page*& page); 
                         // allocates a new, empty page 
+
+  // as above, but pinning the page in a handle, which first gives up
+  // the page it held
+  const Status readPage(File* file, const int PageNo, PageHandle & page);
+  const Status allocPage(File* file, int& PageNo, PageHandle & page);
   const Status flushFile(const File* file); // writing out all dirty pages of the file
   const Status disposePage(File* file, const int PageNo); // dispose of page in file
   void  printSelf();
 
-  const BufStats & getBufStats() const // get buffer pool usage
+  int   getNumBufs() const { return numBufs; } // size of the buffer pool
+
+  // takes up to cnt unpinned frames holding no page or a clean one out
+  // of the pool for the memory governor, dropping their pages, and
+  // returns how many, their pages in frames; and puts frames back
+  const int lendFrames(const int cnt, Page* frames[]);
+  void  returnFrames(const int cnt, Page* const frames[]);
+
+  // true if page is a frame of the pool, as one lent is
+  const bool isFrame(const Page* page) const
   {
+	return page >= bufPool && page < bufPool + numBufs;
+  }
+
+  const BufStats getBufStats() const // get buffer pool usage
+  {
+	lock_guard<mutex> guard(latch);
 	return bufStats;
   }
+  const BufCounts getBufCounts() const // as above, without copying files
+  {
+	lock_guard<mutex> guard(latch);
+	BufCounts c;
+	c.hits = bufStats.hits;
+	c.misses = bufStats.misses;
+	c.diskreads = bufStats.diskreads;
+	c.diskwrites = bufStats.diskwrites;
+	return c;
+  }
   const void clearBufStats() 
   {
+	lock_guard<mutex> guard(latch);
+	// frames point at the counters of their files, which are zeroed
+	// in place
+	map<string, FileBufStats> files;
+	files.swap(bufStats.files);
 	bufStats.clear();
+	for (auto & f : files) f.second = FileBufStats();
+	files.swap(bufStats.files);
   }
 };
 
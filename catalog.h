@@ -1,6 +1,7 @@
 #ifndef CATALOG_H
 #define CATALOG_H
 
+#include <mutex>
 #include "heapfile.h"
 
 
@@ -10,6 +11,7 @@
 
 #define RELCATNAME   "relcat"           // name of relation catalog
 #define ATTRCATNAME  "attrcat"          // name of attribute catalog
+#define STATCATNAME  "statcat"          // name of statistics catalog
 #define MAXNAME      32                 // length of relName, attrName
 #define MAXSTRINGLEN 255                // max. length of string attribute
 
@@ -17,11 +19,14 @@
 // schema of relation catalog:
 //   relation name : char(32)           <-- lookup key
 //   attribute count : integer(4)
+//   sort attribute : char(32)          (empty unless clustered)
 
 
 typedef struct {
   char relName[MAXNAME];                // relation name
   int attrCnt;                          // number of attributes
+  char sortAttr[MAXNAME];               // attribute the records are in
+                                        // ascending order of, or ""
 } RelDesc;
 
 
@@ -48,10 +53,18 @@ class RelCatalog : public HeapFile {
   // remove tuple from catalog
   const Status removeInfo(const string & relation);
 
-  // create a new relation
+  // record the attribute a relation is sorted on ("" if none)
+  const Status setSortAttr(const string & relation, const string & attrName);
+
+  // true if the records of relation are in order of attrName
+  const bool isSortedOn(const string & relation, const string & attrName);
+
+  // create a new relation, whose pages are of format PLAINPAGE or
+  // PAXPAGE
   const Status createRel(const string & relation, 
 		   const int attrCnt, 
-		   const attrInfo attrList[]);
+		   const attrInfo attrList[],
+		   const PageFormat format = PLAINPAGE);
 
   // destroy a relation
   const Status destroyRel(const string & relation);
@@ -112,8 +125,67 @@ class AttrCatalog : public HeapFile {
 };
 
 
+// schema of statistics catalog (one tuple per analyzed attribute):
+//   relation name : char(32)           <-- lookup keys
+//   attribute name : char(32)          <--
+//   record count : integer(4)
+//   sample size : integer(4)
+//   empty count : integer(4)
+//   distinct values : real(4)
+//   min, max value : char(16) each (printable form)
+//   histogram bounds : HISTBUCKETS+1 times real(4)
+//
+// The histogram is equi-depth: each bucket holds the same number of
+// sampled values.  Bounds are kept as sort keys (see UT_statKey), so
+// string attributes are summarized by their first three characters.
+
+#define HISTBUCKETS  8                  // buckets per histogram
+#define STATVALLEN   16                 // length of min/max value
+
+
+typedef struct {
+  char relName[MAXNAME];                // relation name
+  char attrName[MAXNAME];               // attribute name
+  int recCnt;                           // records when analyzed
+  int sampleCnt;                        // records in histogram sample
+  int emptyCnt;                         // empty strings or zero values
+  float distinct;                       // estimated distinct values
+  char minVal[STATVALLEN];              // smallest value
+  char maxVal[STATVALLEN];              // largest value
+  float bounds[HISTBUCKETS + 1];        // histogram bucket boundaries
+} StatDesc;
+
+
+class StatCatalog : public HeapFile {
+ public:
+  // open statistics catalog
+  StatCatalog(Status &status);
+
+  // get statistics of an attribute
+  const Status getInfo(const string & relation,
+		       const string & attrName,
+		       StatDesc &record);
+
+  // add information to catalog
+  const Status addInfo(StatDesc & record);
+
+  // delete statistics of all attributes of a relation
+  const Status dropRelation(const string & relation);
+
+  // close statistics catalog
+  ~StatCatalog();
+};
+
+
+// held by each catalog method, so that a method's scans and updates of
+// the catalogs are not interleaved with those of another server
+// session; recursive, as methods call one another
+
+extern recursive_mutex catLatch;
+
 extern RelCatalog  *relCat;
 extern AttrCatalog *attrCat;
+extern StatCatalog *statCat;
 extern Error error;
 extern Status createHeapFile(const string filename);
 extern Status destroyHeapFile(const string filename);
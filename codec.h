@@ -0,0 +1,164 @@
+#ifndef CODEC_H
+#define CODEC_H
+
+#include <set>
+#include <string>
+#include <vector>
+#include "heapfile.h"
+
+using namespace std;
+
+
+// A compressed page (see page.h) holds in slot 0 a header telling how
+// each attribute of the relation is encoded on that page, and in each
+// other slot one encoded record.  Integers are stored as their
+// difference from the smallest value on the page (frame of reference),
+// in as few bits as the largest difference needs.  Strings are stored
+// either as a code into a sorted dictionary of the distinct values on
+// the page, or as they are, whichever takes less space.  Either way
+// the padding at their end is cut off: a run of nulls, or of the last
+// byte of the first value on the page (blanks, say).  Floats are
+// stored as they are.
+//
+//   header : for each attribute
+//              encoding : char(1), width : char(1)
+//              base : integer(4)                        (FORENC)
+//              pad : char(1)                   (DICTENC, TRUNCENC)
+//              count : short(2), count values           (DICTENC)
+//                each length : char(1), bytes
+//   record : one code of width bits per attribute, rounded up to
+//            whole bytes, then the bytes of each TRUNCENC attribute,
+//            whose code is their number
+//
+// Codes of FORENC and DICTENC attributes are in the order of the
+// values, so a scan turns its comparison value into a range of codes
+// once per page and compares codes from then on.
+
+enum Encoding { RAWENC, FORENC, DICTENC, TRUNCENC };
+
+
+// Decodes the records of the compressed pages of a relation, one page
+// at a time.
+
+class PageCodec {
+ public:
+  PageCodec(const int attrCnt,            // attributes covering
+	    const RecAttr attrs[],       // records of recLen bytes
+	    const int recLen);
+  ~PageCodec();
+
+  // read the header of a compressed page
+  const Status load(const Record & header);
+
+  // decode a record of the page loaded.  The result is overwritten by
+  // the next call.
+  char *decode(const Record & enc);
+
+  // code of attribute i in a record of the page loaded
+  unsigned int code(const Record & enc, const int i) const
+  {
+    return getBits((const unsigned char *) enc.data, codes[i].bitPos,
+		   codes[i].width);
+  }
+
+  // set [lo, hi) to the codes of attribute i of values equal to value.
+  // Codes below lo are of smaller values, codes from hi on of larger
+  // ones.  False if the codes of attribute i are not in value order
+  // on the page loaded.
+  const bool codeRange(const int i, const char *value,
+		       long long & lo, long long & hi) const;
+
+  static unsigned int getBits(const unsigned char *p, const int pos,
+			      const int width)
+  {
+    if (width == 0) return 0;
+    int first = pos >> 3;
+    int cnt = ((pos + width + 7) >> 3) - first;  // 5 bytes at most
+    unsigned long long w = 0;
+    for (int i = 0; i < cnt; i++)
+      w |= (unsigned long long) p[first + i] << (8 * i);
+    return (unsigned int) ((w >> (pos & 7)) & ((1ULL << width) - 1));
+  }
+
+  static void setBits(unsigned char *p, const int pos, const int width,
+		      const unsigned int value)
+  {
+    unsigned long long w = (unsigned long long) value << (pos & 7);
+    int first = pos >> 3;
+    int cnt = ((pos + width + 7) >> 3) - first;
+    for (int i = 0; i < cnt; i++)
+      p[first + i] |= (unsigned char) (w >> (8 * i));
+  }
+
+ private:
+  struct AttrCode
+  {
+    int enc;                              // an Encoding
+    int width;                            // bits of the code
+    int bitPos;                           // first bit of the code
+    int base;                             // smallest value (FORENC)
+    char pad;                             // byte strings were cut of
+    int dictCnt;                          // values in dictionary
+    int dictPos;                          // first value in dict
+  };
+
+  vector<RecAttr> attrs;                 // layout of a record
+  int recLen;                             // length of a record
+  vector<AttrCode> codes;                 // encoding of each attribute
+  vector<char> dict;                      // dictionary values, padded
+  int codeBytes;                          // bytes of codes in a record
+  char *buf;                              // record decoded
+};
+
+
+// Packs records into a compressed page.  Records are added until the
+// next one does not fit, and are then encoded onto the page together.
+
+class PagePacker {
+ public:
+  PagePacker(const int attrCnt,
+	     const RecAttr attrs[],
+	     const int recLen);
+
+  // add a record; false if the page has no room for it
+  const bool add(const Record & rec);
+
+  // number of records added
+  const int count() const { return recCnt; }
+
+  // encode the records added onto an empty page, and start over
+  const Status write(Page *page);
+
+ private:
+  // strings are cut off with either of two pads: null, and the last
+  // byte of the first value
+  struct AttrStats
+  {
+    int min, max;                         // range of integers
+    char pad[2];                          // pads tried
+    int distinct;                         // distinct strings
+    int dictBytes[2];                     // bytes of their dictionary
+    int cutBytes[2];                      // bytes of strings cut off
+    int maxCut[2];                        // longest string cut off
+  };
+
+  // encoding of an attribute: encoding, width, header and data bytes
+  struct Choice
+  {
+    int enc, width, hdrBytes, dataBytes;
+    char pad;
+  };
+
+  const Choice choose(const int i, const AttrStats & s, const int n) const;
+  const int pageBytes(const vector<AttrStats> & s, const int n) const;
+  const int cutLen(const int i, const char *value, const char pad) const;
+
+  vector<RecAttr> attrs;
+  int recLen;
+  vector<AttrStats> stats;                // of the records added
+  vector<set<string> > values;            // distinct strings
+  vector<char> recs;                      // records added
+  int recCnt;
+};
+
+#endif
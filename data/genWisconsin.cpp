@@ -0,0 +1,301 @@
+//=============================================================================
+// Generate Wisconsin benchmark style tuples
+//
+// Usage: genWisconsin [-u] [-z theta] [-d ratio] [-s seed]
+//                     <total num tuples> <output filename>
+//
+// Tuples are written one at a time, so the number of tuples is limited
+// only by disk space.  unique1 is a pseudo-random permutation of
+// 0..n-1 computed on the fly by cycle walking a bijection on the next
+// power of two; unique2 is 0..n-1 in order.  The remaining integer
+// attributes are derived from unique1 as in the Wisconsin benchmark.
+//
+// skewed has duplicates and skew controlled by the knobs:
+//   -d ratio   fraction of duplicates; values are drawn from a domain of
+//              n * (1 - ratio) values (default 0, i.e. a domain of n)
+//   -z theta   Zipf skew in [0, 1); 0 gives a uniform distribution
+//
+// The records match this relation (212 bytes):
+//
+//   create table wisc (unique1 int, unique2 int, two int, four int,
+//       ten int, twenty int, onePercent int, tenPercent int,
+//       twentyPercent int, fiftyPercent int, unique3 int,
+//       evenOnePercent int, oddOnePercent int, skewed int,
+//       stringu1 char(52), stringu2 char(52), string4 char(52));
+//
+// With -u only a single int is written per tuple, unique1 or skewed
+// if a knob is given, like the files made by genWITuples.
+//=============================================================================
+
+#include <string.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define STRINGLEN 52
+
+typedef struct {
+    int unique1;
+    int unique2;
+    int two;
+    int four;
+    int ten;
+    int twenty;
+    int onePercent;
+    int tenPercent;
+    int twentyPercent;
+    int fiftyPercent;
+    int unique3;
+    int evenOnePercent;
+    int oddOnePercent;
+    int skewed;
+    char stringu1[STRINGLEN];
+    char stringu2[STRINGLEN];
+    char string4[STRINGLEN];
+} WisconsinTuple;
+
+typedef unsigned long long u64;
+
+static u64 rngState;
+
+// returns a uniformly distributed 64 bit value (splitmix64)
+static u64 nextRandom()
+{
+    u64 z = (rngState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// returns a uniformly distributed value in [0, 1)
+static double nextUniform()
+{
+    return (nextRandom() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Permutation of 0..n-1: a few rounds of multiply/add and xorshift form
+// a bijection on [0, 2^bits); values >= n are skipped.
+//-----------------------------------------------------------------------------
+
+static u64 permMask;
+static int permShift;
+static u64 permMul[3], permAdd[3];
+
+static void initPermutation(u64 n)
+{
+    int bits = 1;
+    while ((1ULL << bits) < n) bits++;
+    permMask = (1ULL << bits) - 1;
+    permShift = (bits + 1) / 2;
+    for (int r = 0; r < 3; r++)
+    {
+        permMul[r] = nextRandom() | 1;  // odd, hence invertible
+        permAdd[r] = nextRandom();
+    }
+}
+
+static u64 permute(u64 x)
+{
+    for (int r = 0; r < 3; r++)
+    {
+        x = (x * permMul[r] + permAdd[r]) & permMask;
+        x ^= x >> permShift;
+    }
+    return x;
+}
+
+
+//-----------------------------------------------------------------------------
+// Zipf distribution over 0..domain-1 (Gray et al., "Quickly Generating
+// Billion-Record Synthetic Databases", SIGMOD 1994).  Ranks are
+// scattered over the domain so the frequent values are not all small.
+//-----------------------------------------------------------------------------
+
+static double zipfTheta, zipfZetan, zipfAlpha, zipfEta;
+static u64 zipfDomain, zipfStride;
+
+static u64 gcd(u64 a, u64 b)
+{
+    while (b) { u64 t = a % b; a = b; b = t; }
+    return a;
+}
+
+static void initZipf(u64 domain, double theta)
+{
+    zipfDomain = domain;
+    zipfTheta = theta;
+
+    // a stride coprime with the domain maps ranks one to one
+    zipfStride = 2654435761ULL % domain;
+    while (gcd(zipfStride, domain) != 1)
+        zipfStride++;
+
+    if (theta <= 0) return;
+
+    zipfZetan = 0;
+    for (u64 i = 1; i <= domain; i++)
+        zipfZetan += 1.0 / pow((double) i, theta);
+    double zeta2 = 1.0 + pow(0.5, theta);
+    zipfAlpha = 1.0 / (1.0 - theta);
+    zipfEta = (1.0 - pow(2.0 / domain, 1.0 - theta)) /
+              (1.0 - zeta2 / zipfZetan);
+}
+
+static u64 nextZipf()
+{
+    u64 rank;
+    double u = nextUniform();
+
+    if (zipfTheta <= 0)
+        rank = (u64) (u * zipfDomain);
+    else
+    {
+        double uz = u * zipfZetan;
+        if (uz < 1.0)
+            rank = 0;
+        else if (uz < 1.0 + pow(0.5, zipfTheta))
+            rank = 1;
+        else
+            rank = (u64) (zipfDomain *
+                          pow(zipfEta * u - zipfEta + 1.0, zipfAlpha));
+    }
+    if (rank >= zipfDomain) rank = zipfDomain - 1;
+    return (rank * zipfStride) % zipfDomain;
+}
+
+
+// Wisconsin string attribute: value in base 26 left aligned, padded
+static void convert(int value, char *s)
+{
+    char tmp[8];
+    int len = 0;
+
+    memset(s, 'x', STRINGLEN);
+    for (int i = 0; i < 7; i++)
+    {
+        tmp[len++] = 'A' + value % 26;
+        value /= 26;
+    }
+    for (int i = 0; i < len; i++)
+        s[i] = tmp[len - 1 - i];
+}
+
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [-u] [-z theta] [-d ratio] [-s seed] "
+            "<total num tuples> <output filename>\n", prog);
+    exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+    bool unique1Only = false;
+    bool knobs = false;
+    double theta = 0;
+    double dupRatio = 0;
+    u64 seed = 1;
+
+    int c;
+    while ((c = getopt(argc, argv, "uz:d:s:")) != -1)
+    {
+        switch (c)
+        {
+        case 'u': unique1Only = true; break;
+        case 'z': theta = atof(optarg); knobs = true; break;
+        case 'd': dupRatio = atof(optarg); knobs = true; break;
+        case 's': seed = strtoull(optarg, NULL, 10); break;
+        default: usage(argv[0]);
+        }
+    }
+    if (argc - optind != 2) usage(argv[0]);
+
+    long long tupleCount = atoll(argv[optind]);
+    char *outputFilename = argv[optind + 1];
+
+    if (tupleCount <= 0 || tupleCount > 0x7fffffffLL)
+    {
+        fprintf(stderr, "number of tuples must be between 1 and 2^31-1\n");
+        return 1;
+    }
+    if (theta < 0 || theta >= 1 || dupRatio < 0 || dupRatio >= 1)
+    {
+        fprintf(stderr, "theta and ratio must be in [0, 1)\n");
+        return 1;
+    }
+
+    FILE *out = fopen(outputFilename, "wb");
+    if (out == NULL)
+    {
+        perror("Error opening file for writing");
+        return 1;
+    }
+    setvbuf(out, NULL, _IOFBF, 1 << 20);
+
+    rngState = seed;
+    initPermutation(tupleCount);
+    u64 domain = (u64) (tupleCount * (1.0 - dupRatio));
+    initZipf(domain ? domain : 1, theta);
+
+    WisconsinTuple t;
+    memset(t.string4, 'x', STRINGLEN);
+
+    u64 x = 0;
+    for (long long i = 0; i < tupleCount; i++)
+    {
+        // next value of the permutation below tupleCount
+        u64 v;
+        do v = permute(x++); while (v >= (u64) tupleCount);
+
+        int skewed = (int) nextZipf();
+
+        if (unique1Only)
+        {
+            int value = knobs ? skewed : (int) v;
+            if (fwrite(&value, sizeof value, 1, out) != 1)
+            {
+                perror("Error writing tuple");
+                return 1;
+            }
+            continue;
+        }
+
+        t.unique1 = (int) v;
+        t.unique2 = (int) i;
+        t.two = t.unique1 % 2;
+        t.four = t.unique1 % 4;
+        t.ten = t.unique1 % 10;
+        t.twenty = t.unique1 % 20;
+        t.onePercent = t.unique1 % 100;
+        t.tenPercent = t.unique1 % 10;
+        t.twentyPercent = t.unique1 % 5;
+        t.fiftyPercent = t.unique1 % 2;
+        t.unique3 = t.unique1;
+        t.evenOnePercent = t.onePercent * 2;
+        t.oddOnePercent = t.onePercent * 2 + 1;
+        t.skewed = skewed;
+        convert(t.unique1, t.stringu1);
+        convert(t.unique2, t.stringu2);
+        memset(t.string4, "AHOV"[i % 4], 4);
+
+        if (fwrite(&t, sizeof t, 1, out) != 1)
+        {
+            perror("Error writing tuple");
+            return 1;
+        }
+    }
+
+    if (fclose(out) != 0)
+    {
+        perror("Error closing output file");
+        return 1;
+    }
+    printf("Done.\n");
+    return 0;
+
+} // end main
@@ -3,6 +3,7 @@
 
 #include <sys/types.h>
 #include <functional>
+#include <mutex>
 #include "error.h"
 #include <string.h>
 using namespace std;
@@ -29,6 +30,7 @@ class File {
   const Status writePage(const int pageNo,
 		   const Page* pagePtr);      // write page to file
   const Status getFirstPage(int& pageNo) const;     // returns pageNo of first page
+  const string & getName() const { return fileName; } // name of the file
 
   bool operator == (const File & other) const
     {
@@ -63,6 +65,59 @@ class File {
 class BufMgr;
 extern BufMgr* bufMgr;
 
+
+// statistics on the physical I/O done by File::intread and
+// File::intwrite; latencies are kept as histograms with power of two
+// buckets in microseconds (bucket i counts latencies below 2^(i+1) us)
+
+#define IOHISTBUCKETS 16
+
+struct IOStats
+{
+  int reads;                          // pages read
+  int writes;                         // pages written
+  double bytesRead;                   // bytes read
+  double bytesWritten;                // bytes written
+  double readTime;                    // total read latency (us)
+  double writeTime;                   // total write latency (us)
+  int readHist[IOHISTBUCKETS];        // read latency histogram
+  int writeHist[IOHISTBUCKETS];       // write latency histogram
+
+  void clear()
+    {
+      reads = writes = 0;
+      bytesRead = bytesWritten = readTime = writeTime = 0;
+      memset(readHist, 0, sizeof(readHist));
+      memset(writeHist, 0, sizeof(writeHist));
+    }
+
+  IOStats()
+    {
+      clear();
+    }
+};
+
+// monotonic time stamp in microseconds, and counting pages read or
+// written in the physical I/O statistics; for I/O done outside File.
+// Server sessions and the flusher do I/O at the same time, so the
+// statistics are only counted, copied and cleared under a latch.
+double ioClock();
+void ioCount(const bool write, const int pages, const long bytes,
+	     const double usecs);
+const IOStats ioSnapshot();
+void ioStatsClear();
+
+// pages read and written, and buffer pool hits, by the calling thread,
+// so that a server session can measure its own work while others run
+struct ThreadIOCounts
+{
+  int reads;
+  int writes;
+  int hits;
+};
+
+extern thread_local ThreadIOCounts threadIO;
+
 // declarations for hash table of open files
 struct fileHashBucket
 {
@@ -111,6 +166,7 @@ class DB {
 
  private:
   OpenFileHashTbl   openFiles;    // list of open files
+  mutex             latch;        // serializes the open file table
 };
 
 
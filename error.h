@@ -49,9 +49,12 @@ enum Status {
 
 // Utility errors
 
+       BADUTILPARM,
+
 // Query errors
 
-       ATTRTYPEMISMATCH, TMP_RES_EXISTS,
+       ATTRTYPEMISMATCH, TMP_RES_EXISTS, BADAGGPARM, BADORDERPARM,
+       AGGOVERFLOW,
 
 // do not touch filler -- add codes before it
 
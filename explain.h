@@ -0,0 +1,81 @@
+#ifndef EXPLAIN_H
+#define EXPLAIN_H
+
+#include <vector>
+#include <string>
+using namespace std;
+
+
+// ExplainNode holds the measurements of one phase of a query run
+// under explain analyze.  Phases form a tree following the nesting
+// of the code that executes them; a phase entered repeatedly under
+// the same parent (e.g., once per block of a join) is accumulated in a
+// single node.  Times and I/O counts of a node include its children.
+// They are those of the thread running the query, so that sessions of
+// a server do not count each other's work; CPU time of threads working
+// for it, such as those of the parallel hash join, is added with
+// explainAddCpu.  Pages the flusher writes are not counted.
+
+struct ExplainNode
+{
+  string name;                          // phase name
+  ExplainNode *parent;                  // enclosing phase
+  vector<ExplainNode*> children;        // phases run within this one
+  int loops;                            // times the phase was entered
+  double tuplesIn;                      // tuples consumed
+  double tuplesOut;                     // tuples produced
+  double wall;                          // elapsed time (us)
+  double cpu;                           // CPU time (us)
+  int reads;                            // pages read from disk
+  int writes;                           // pages written to disk
+  int hits;                             // buffer pool hits
+
+  ExplainNode(const string & name, ExplainNode *parent);
+  ~ExplainNode();
+
+  ExplainNode *child(const string & name); // find or add a child phase
+};
+
+
+// innermost phase being measured; NULL unless a query is being
+// explained, in which case ExplainPhase does nothing.  Per thread, as
+// each server session explains its own queries.
+
+extern thread_local ExplainNode *explainNode;
+
+
+// ExplainPhase measures a phase from construction until end() is
+// called or it goes out of scope.  The name may be qualified by an
+// argument such as a relation name ("scan" "stars").
+
+class ExplainPhase
+{
+ public:
+  ExplainPhase(const char *name, const char *arg = NULL);
+  ~ExplainPhase() { if (node) end(); }
+
+  void in(const int n = 1) { if (node) node->tuplesIn += n; }
+  void out(const int n = 1) { if (node) node->tuplesOut += n; }
+  void end();                           // stop measuring the phase
+
+ private:
+  ExplainNode *node;                    // phase node, NULL if not explaining
+  double wall, cpu;                     // clocks at start of phase
+  int reads, writes, hits;              // counters at start of phase
+};
+
+
+// CPU time in microseconds of the calling thread and of the helper
+// threads it has waited for; and adding the CPU time of a helper
+
+double explainCpuClock();
+void explainAddCpu(const double usecs);
+
+
+// start explaining the next query / print the measured phases
+// as a tree or as JSON and stop explaining
+
+void QU_ExplainStart(void);
+void QU_ExplainFinish(const bool json);
+
+#endif
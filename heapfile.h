@@ -10,6 +10,11 @@ using namespace std;
 
 #include "page.h"
 #include "buf.h"
+#include "relcache.h"
+
+class RuntimeFilter;
+class PageCodec;
+class PagePacker;
 
 extern DB db;
 
@@ -22,6 +27,38 @@ const unsigned MAXNAMESIZE = 50;
 enum Datatype { STRING, INTEGER, FLOAT };    // attribute data types
 enum Operator { LT, LTE, EQ, GTE, GT, NE };  // scan operators
 
+// kernels comparing two attribute values of one type, and testing
+// `attr op filter' for one type and operator (see kernel.h)
+typedef int (*AttrCmpFn)(const char *p1, const char *p2, const int len);
+typedef bool (*AttrMatchFn)(const char *attr, const char *filter,
+			    const int len);
+
+// most attributes of a heap file summarized by a zone map
+const int MAXZONEATTRS = 4;
+
+// most bytes of a string attribute kept as a zone map bound
+const int ZONEKEYLEN = 16;
+
+// attribute summarized by the zone map of a heap file
+struct ZoneAttr
+{
+  int		offset;		// byte offset of attribute
+  int		length;		// length of attribute
+  Datatype	type;		// datatype of attribute
+};
+
+// most attributes in the record layout of a heap file
+const int MAXRECATTRS = 40;
+
+// attribute of the records of a heap file with compressed or PAX
+// pages, which need to know where each attribute lies in a record
+struct RecAttr
+{
+  int		offset;		// byte offset of attribute
+  int		length;		// length of attribute
+  Datatype	type;		// datatype of attribute
+};
+
 struct FileHdrPage
 {
   char		fileName[MAXNAMESIZE];   // name of file
@@ -29,22 +66,104 @@ struct FileHdrPage
   int		lastPage;	// pageNo of last data page in file
   int		pageCnt;	// number of pages
   int		recCnt;		// record count
+  int		zoneCnt;	// number of attributes with zone maps
+  int		zonePageCnt;	// pages of the zone map file
+  ZoneAttr	zoneAttrs[MAXZONEATTRS]; // attributes with zone maps
+  int		recAttrCnt;	// attributes of the records, 0 if unknown
+  int		recLen;		// length of a record
+  RecAttr	recAttrs[MAXRECATTRS]; // layout of the records
+  int		compressed;	// records are packed into compressed pages
+  int		pageFormat;	// PageFormat of pages added to the file
+};
+
+
+// A zone map keeps, for every data page of a heap file, the smallest
+// and largest value on the page of each attribute in zoneAttrs, so
+// that a filtered scan can pass over pages that cannot hold a match
+// without reading them.  It lives in the file <heap file>.zm, where
+// the entry of data page p is entry p of a dense array of entries
+// starting on page 1.  An entry also repeats the next page link of
+// its data page, since a page that is skipped is never read:
+//
+//   nextPage : integer(4)
+//   state : integer(4)            (ZONEUNKNOWN, ZONEEMPTY, ZONEBOUNDS)
+//   min, max of each attribute     (ZONEKEYLEN bytes at most, each)
+//
+// Inserts widen the bounds of their page; deleting records leaves
+// them alone, except that a set-oriented delete recomputes them for
+// the pages it changes.  String bounds are prefixes of the values.
+
+enum ZoneState { ZONEUNKNOWN, ZONEEMPTY, ZONEBOUNDS };
+
+struct ZoneEntry
+{
+  int		nextPage;	// next page link of the data page
+  int		state;		// a ZoneState
+  // followed by the min and max of each attribute with a zone map
 };
 
 
 // class definition of heapFile
 class HeapFile {
 protected:
+   RelHandle*	handle;		// the file in the relation cache
    File* 	filePtr;        // underlying DB File object
    FileHdrPage*  headerPage;	// pinned file header page in buffer pool
    int		headerPageNo;	// page number of header page
    bool		hdrDirtyFlag;   // true if header page has been updated
 
-   Page* 	curPage;	// data page currently pinned in buffer pool
+   PageHandle	curPage;	// data page currently pinned in buffer pool
    int   	curPageNo;	// page number of pinned page
-   bool  	curDirtyFlag;   // true if page has been updated
    RID   	curRec;         // rid of last record returned
 
+   // length of a zone map entry and of the bounds of each attribute
+   const int zoneEntryLen() const;
+   const int zoneKeyLen(const int i) const;
+
+   // pin the zone map page holding the entry of data page pageNo in
+   // zonePage, extending the zone map file if needed
+   const Status pinZone(const int pageNo, ZoneEntry *&entry,
+			PageHandle &zonePage);
+
+   // widen the bounds of a zone map entry by a record
+   void addToZone(ZoneEntry *entry, const Record & rec) const;
+
+   // set the entry of a data page from the records on it
+   const Status summarizePage(const int pageNo, Page *page);
+
+   // widen the bounds of the entry of the current page by a record
+   const Status widenZone(const Record & rec);
+
+   // set the next page link of the entry of data page pageNo; a new
+   // page is marked empty
+   const Status linkZone(const int pageNo, const int nextPageNo,
+			 const bool empty);
+
+   // summarize every page of the file in a new zone map file
+   const Status rebuildZones();
+
+   PageCodec*	codec;		// decodes compressed pages, NULL if none
+   int		codecPageNo;	// page whose header codec has loaded
+   char*	recBuf;		// record gathered from a PAX page
+   vector<short> attrAt;	// attribute of recAttrs at each offset, or -1
+
+   // set up reading records of the layout in the header
+   void openLayout();
+
+   // check a record layout and write it to the header
+   const Status setLayout(const int attrCnt,
+			  const RecAttr attrs[],
+			  const int recLen);
+
+   // read the header of a compressed page into codec, unless it is
+   // there already
+   const Status loadCodec(Page *page, const int pageNo);
+
+   // get a record of a page, decoding it if the page is compressed
+   // and gathering it if it is a PAX page
+   const Status readRecord(Page *page, const int pageNo, const RID & rid,
+			   Record & rec);
+
 public:
 
   // initialize
@@ -56,8 +175,36 @@ public:
   // return number of records in file
   const int getRecCnt() const;
 
+  // return number of data pages in file
+  const int getPageCnt() const;
+
   // given a RID, read record from file, returning pointer and length
   const Status getRecord(const RID &rid, Record & rec);
+
+  // keep a zone map for the attribute at offset, summarizing every
+  // page of the file now and every page inserted into later
+  const Status addZoneMap(const int offset,
+			  const int length,
+			  const Datatype type);
+
+  // drop the zone map of the attribute at offset, or all of them if
+  // offset is negative
+  const Status dropZoneMap(const int offset);
+
+  // true if the attribute at offset has a zone map
+  const bool hasZoneMap(const int offset) const;
+
+  // true if the file has compressed pages
+  const bool isCompressed() const { return headerPage->compressed; }
+
+  // store the records of the file, which must be empty, in PAX pages.
+  // attrs must cover the records, which are all recLen bytes long.
+  const Status setPax(const int attrCnt,
+		      const RecAttr attrs[],
+		      const int recLen);
+
+  // true if pages added to the file are PAX pages
+  const bool isPax() const { return headerPage->pageFormat == PAXPAGE; }
 };
 
 
@@ -86,18 +233,45 @@ public:
     // read current record, returning pointer and length
     const Status getRecord(Record & rec);
 
+    // returns pointer to the attribute at offset of the current record,
+    // read from its minipage on a PAX page
+    const Status getAttr(const int offset, const char *& attr);
+
     // delete current record 
     const Status deleteRecord();
 
+    // delete all records that satisfy the scan, a page at a time,
+    // returning how many were deleted; ends the scan
+    const Status deleteMatching(int & deleted);
+
     // marks current page of scan dirty
     const Status markDirty();
 
+    // in addition to the scan predicate, skip records whose attribute
+    // at offset the runtime filter rules out (NULL for none)
+    void setRuntimeFilter(RuntimeFilter *rtFilter, const int rtOffset);
+
+    // number of pages passed over without reading them because their
+    // zone map ruled out a match
+    const int getPagesSkipped() const { return pagesSkipped; }
+
+    // the file is in ascending order of the filter attribute: end the
+    // scan at the first record past the filter's upper bound
+    void setSorted() { sorted = true; }
+
 private:
     int   offset;            // byte offset of filter attribute
     int   length;            // length of filter attribute
     Datatype type;           // datatype of filter attribute
     const char* filter;      // comparison value of filter
     Operator op;             // comparison operator of filter
+    AttrMatchFn matchFn;     // kernel of the filter's type and operator
+    AttrCmpFn cmpFn;         // kernel comparing values of its type
+    RuntimeFilter* rtFilter; // runtime filter on join attribute, or NULL
+    int   rtOffset;          // byte offset of join attribute
+    int   zoneAttr;          // zone map of filter attribute, -1 if none
+    int   pagesSkipped;      // pages the zone map ruled out
+    bool  sorted;            // file is in order of filter attribute
 
      // The following variables are used to preserve the state
     // of the scan when the method markScan() is invoked.
@@ -107,6 +281,37 @@ private:
     RID   markedRec;         // rid of last record returned
 
     const bool matchRec(const Record & rec) const;
+
+    // true if the filter attribute value attr passes the filter
+    const bool matchAttr(const char *attr) const;
+
+    // true if the record and all after it in a sorted file fail the
+    // filter
+    const bool pastFilter(const Record & rec) const;
+    const bool pastAttr(const char *attr) const;
+
+    // unpins the current page and returns FILEEOF from now on
+    const Status stopScan();
+
+    // false if the zone map entry shows the page holds no match
+    const bool matchZone(const ZoneEntry *entry) const;
+
+    // the first page, starting at pageNo, that may hold a match
+    const Status skipPages(int & pageNo);
+
+    int   layoutAttr;        // filter attribute in recAttrs, -1 if none
+    int   rtAttr;            // join attribute in recAttrs, -1 if none
+    int   rangePageNo;       // page the code range below is of
+    bool  rangeOk;           // filter compares codes on that page
+    long long codeLo, codeHi; // codes of values equal to the filter
+
+    // evaluates the scan predicate on a record of the current page;
+    // past is set if it and all records after it in a sorted file
+    // fail the filter
+    const Status checkRec(const RID & rid, bool & match, bool & past);
+
+    RID   attrRid;           // compressed record getAttr decoded last,
+    char* attrData;          // and its decoded data
 };
 
 
@@ -121,6 +326,26 @@ public:
 
     // insert record into file, returning its RID
     const Status insertRecord(const Record & rec, RID& outRid); 
+
+    // fill pages only up to percent of their space, leaving the rest
+    // free
+    void setFillFactor(const int percent);
+
+    // pack the records inserted from now on into compressed pages.
+    // attrs must cover the records, which are all recLen bytes long.
+    const Status setCompression(const int attrCnt,
+				const RecAttr attrs[],
+				const int recLen);
+
+    // write out the records packed but not yet on a page
+    const Status flushPage();
+
+private:
+    int   reserve;           // bytes to leave free on each page
+    PagePacker* packer;      // packs compressed pages, NULL if none
+
+    // link a new empty page after the current one and make it current
+    const Status addPage();
 };
 
 #endif
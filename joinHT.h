@@ -1,19 +1,39 @@
+#include "kernel.h"
+
+// least pages worth of memory that the hash joins fill with outer
+// tuples before each scan of the inner; a block is as large as the
+// memory governor grants, up to all of the outer.  Only the join
+// attribute and the projected attributes of an outer tuple are kept,
+// so a block holds more outer tuples than this many pages of the
+// outer relation.
+const int HJBLOCKSIZE = 256;
+
+// pages worth of memory the parallel hash join fills with inner
+// tuples between result appends
+const int PHJCHUNKSIZE = 4096;
+
+// target size of a partition of the outer in the parallel hash join,
+// about what a core's cache holds
+const int PHJPARTBYTES = 256 * 1024;
+
+// most worker threads the parallel hash join uses
+const int PHJMAXTHREADS = 64;
+
+
+// The hash table keeps its own copy of the join attribute value and
+// of the projected attributes of every outer tuple inserted, so the
+// probe side can build output tuples without going back to the outer
+// relation.  The copies are carved out of a few large chunks of memory
+// that are released together when the table is destroyed.
 
 class joinHashTbl
 {
 private:
-    union JAttrType
-    {
-	int iValue;
-	float fValue;
-	char* sValue;
-    };
-	
     struct joinhashBucket
     {
-	union JAttrType	attrValue;
-       	RID	rid;
        	joinhashBucket*     next;    // next node in the hash table
+	// followed by the join attribute value (joinAttr.attrLen bytes)
+	// and the projected attributes (projLen bytes)
     };
 
     struct HTentry
@@ -22,19 +42,61 @@ private:
 	joinhashBucket*   chain;  // pointer to first bucket on the chain
     };
 
+    struct arenaChunk
+    {
+	arenaChunk* next;    // next chunk allocated
+	// followed by the chunk's memory
+    };
+
     AttrDesc 	joinAttr;
     int 	HTSIZE;
     HTentry 	*ht; // actual hash table
-    int  hash(const char* attr, int attrType); // returns value between 0 and HTSIZE-1
+
+    int		projCnt;     // number of projected attributes
+    AttrDesc	*projAttrs;  // projected attributes of the outer
+    int		keyLen;      // join attribute length, rounded up for alignment
+    int		projLen;     // total length of the projected attributes
+
+    arenaChunk	*chunks;     // memory the buckets are carved from
+    char	*freePtr;    // next free byte in the current chunk
+    int		freeLen;     // bytes left in the current chunk
+
+    const char	**matches;   // result array handed out by lookup
+    int		matchesLen;  // its size
+
+    // kernels of the type of the join attribute, picked by the
+    // constructor: its hash, and the scan of a chain for the values
+    // equal to a key, instantiated for each type
+    AttrHashFn	hashFn;
+    void	(joinHashTbl::*probeFn)(const joinhashBucket* chain,
+					const char* key, int & matchCnt);
+    template <Datatype T>
+    void probe(const joinhashBucket* chain, const char* key, int & matchCnt);
+
+    int  hash(const char* attr); // returns value between 0 and HTSIZE-1
+    char *alloc(const int len);                // allocates len bytes from the chunks
 
 public:
-    joinHashTbl(const int size, const AttrDesc attr);  // constructor
+    // attr is the join attribute of the outer relation and projAttrs
+    // the attributes of the outer relation kept with each tuple
+    joinHashTbl(const int size, const AttrDesc attr,
+		const int projCnt = 0, const AttrDesc projAttrs[] = NULL);
     ~joinHashTbl();
 
-     // insert a new (JoinAttrValue, RID) pair into hash table
-     Status insert(const RID newRid,  const char* tuple);
+     // copy the join attribute value and the projected attributes of
+     // an outer tuple into the hash table
+     Status insert(const char* tuple);
 
-     // get RIDs of records whose join attribute value matches innerJoinAttrValue
-     Status lookup(const char* innerJoinAttrPtr, int & ridCount, RID *&outRids);
-};
+     // get the projected attributes of the outer tuples whose join
+     // attribute value matches innerJoinAttrValue.  Each entry of
+     // outTuples points to projLen bytes holding the projected
+     // attributes in the order given to the constructor.  The array
+     // belongs to the hash table and is reused by the next lookup.
+     Status lookup(const char* innerJoinAttrPtr, int & matchCnt,
+		   const char **&outTuples);
 
+     // number of bytes kept for each outer tuple inserted into a table
+     // built with these arguments
+     static int tupleSize(const AttrDesc & attr, const int projCnt,
+			  const AttrDesc projAttrs[]);
+};
@@ -0,0 +1,153 @@
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include <string.h>
+#include "heapfile.h"
+
+using namespace std;
+
+
+// Kernels that compare, match and hash attribute values, instantiated
+// for every Datatype and Operator.  Scans, sorts and joins pick the
+// kernel of their attribute once, when they are set up, instead of
+// switching on the type and operator for every tuple.  Sorts and the
+// radix partitioning of the parallel hash join are instantiated around
+// a kernel, so their inner loops call it inline; hash tables hash
+// through a kernel pointer and probe through a member instantiated
+// for the type, both picked when the table is made.
+//
+// INTEGER and FLOAT values are sizeof(int) bytes and may be unaligned.
+// STRING values are compared over the length of the attribute, but not
+// past a null, and compare as strncmp does.  cmp returns <0, 0 or >0
+// like strcmp; floats are compared, not subtracted, so values less
+// than 1 apart do not compare equal.
+
+template <Datatype T> struct AttrKernel;
+
+template <> struct AttrKernel<INTEGER>
+{
+  static int cmp(const char *p1, const char *p2, const int)
+  {
+    int v1, v2;
+    memcpy(&v1, p1, sizeof(int));
+    memcpy(&v2, p2, sizeof(int));
+    return (v1 > v2) - (v1 < v2);
+  }
+
+  static unsigned int hash(const char *p, const int)
+  {
+    unsigned int value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+  }
+};
+
+template <> struct AttrKernel<FLOAT>
+{
+  static int cmp(const char *p1, const char *p2, const int)
+  {
+    float v1, v2;
+    memcpy(&v1, p1, sizeof(float));
+    memcpy(&v2, p2, sizeof(float));
+    return (v1 > v2) - (v1 < v2);
+  }
+
+  // equal values must hash alike, and 0.0 == -0.0
+  static unsigned int hash(const char *p, const int)
+  {
+    float fValue;
+    unsigned int value;
+    memcpy(&fValue, p, sizeof(float));
+    if (fValue == 0) fValue = 0;
+    memcpy(&value, &fValue, sizeof(value));
+    return value;
+  }
+};
+
+template <> struct AttrKernel<STRING>
+{
+  static int cmp(const char *p1, const char *p2, const int len)
+  {
+    return strncmp(p1, p2, len);
+  }
+
+  // strings are padded with nulls up to the attribute length
+  static unsigned int hash(const char *p, const int len)
+  {
+    unsigned int value = 0;
+    for (int i = 0; i < len && p[i]; i++)
+      value = 31 * value + (unsigned char) p[i];
+    return value;
+  }
+};
+
+
+// true if `v1 op v2' holds, given cmp(v1, v2); folded to a single test
+// when op is a constant
+
+inline bool cmpHolds(const Operator op, const int cmp)
+{
+  switch (op) {
+  case LT:  return cmp < 0;
+  case LTE: return cmp <= 0;
+  case EQ:  return cmp == 0;
+  case GTE: return cmp >= 0;
+  case GT:  return cmp > 0;
+  case NE:  return cmp != 0;
+  }
+  return false;
+}
+
+template <Datatype T, Operator Op>
+bool attrMatch(const char *attr, const char *filter, const int len)
+{
+  return cmpHolds(Op, AttrKernel<T>::cmp(attr, filter, len));
+}
+
+
+// Kernels of a type and operator known only at run time (AttrCmpFn
+// and AttrMatchFn are in heapfile.h, for HeapFileScan)
+
+typedef unsigned int (*AttrHashFn)(const char *p, const int len);
+
+inline AttrCmpFn attrCmpFn(const Datatype type)
+{
+  switch (type) {
+  case INTEGER: return AttrKernel<INTEGER>::cmp;
+  case FLOAT:   return AttrKernel<FLOAT>::cmp;
+  default:      return AttrKernel<STRING>::cmp;
+  }
+}
+
+inline AttrHashFn attrHashFn(const Datatype type)
+{
+  switch (type) {
+  case INTEGER: return AttrKernel<INTEGER>::hash;
+  case FLOAT:   return AttrKernel<FLOAT>::hash;
+  default:      return AttrKernel<STRING>::hash;
+  }
+}
+
+template <Datatype T>
+AttrMatchFn attrMatchFn(const Operator op)
+{
+  switch (op) {
+  case LT:  return attrMatch<T, LT>;
+  case LTE: return attrMatch<T, LTE>;
+  case EQ:  return attrMatch<T, EQ>;
+  case GTE: return attrMatch<T, GTE>;
+  case GT:  return attrMatch<T, GT>;
+  default:  return attrMatch<T, NE>;
+  }
+}
+
+inline AttrMatchFn attrMatchFn(const Datatype type, const Operator op)
+{
+  switch (type) {
+  case INTEGER: return attrMatchFn<INTEGER>(op);
+  case FLOAT:   return attrMatchFn<FLOAT>(op);
+  default:      return attrMatchFn<STRING>(op);
+  }
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef MEMGOV_H
+#define MEMGOV_H
+
+#include <mutex>
+#include "page.h"
+
+using namespace std;
+
+// define if debug output wanted
+//#define DEBUGMEMGOV
+
+
+// pages of memory minirel uses in all, the buffer pool included,
+// unless started with MEM=<pages>
+const int MEMBUDGET = 32768;
+
+// with MEM=<pages> and no buffer count, the buffer pool gets
+// 1/MEMPOOLSHARE of the budget
+const int MEMPOOLSHARE = 4;
+
+
+// memory governor counters
+struct MemStats
+{
+  int budget;       // pages of memory in all
+  int poolPages;    // frames of the buffer pool
+  int borrowed;     // frames of the pool lent out as temp file pages
+  int granted;      // pages granted and not yet released
+  int peak;         // most pages granted at once
+  int grants;       // grants made
+  int shortGrants;  // grants of less than was wanted
+  int overcommits;  // grants past the budget, to give the minimum
+};
+
+
+// The memory governor hands out the memory operators keep their work
+// in: sort buffers, hash join blocks, aggregation tables and the pages
+// of temporary files.  It has a budget of pages, of which the buffer
+// pool takes its frames; an operator asks for what it wants and the
+// least it can do with, and is granted what it wants as long as the
+// budget has room.  The least an operator asks for is granted even
+// past the budget, so operators always run with at least the memory
+// they used to have.
+//
+// When what the budget leaves beside the buffer pool runs short, the
+// temp space borrows unpinned frames of the pool and keeps the pages
+// of temporary files in them, giving them back as the files shrink.
+// Those frames hold no cached page while they are lent; the pool only
+// lends frames that are empty or clean, so lending does no I/O.
+//
+// Server sessions share the governor; the latch serializes its
+// methods.  It is taken after the latch of the temp space and before
+// that of the buffer manager.
+
+class MemGovernor
+{
+ public:
+  MemGovernor(const int budget, const int poolPages);
+
+  // pages granted, at least min and at most want unless min is more
+  const int grant(const int want, const int min);
+
+  // gives back pages granted
+  void release(const int pages);
+
+  // pages that could be granted within the budget
+  const int getFree() const;
+
+  // borrows up to cnt frames of the buffer pool, returning how many,
+  // their pages in frames; and gives frames borrowed back
+  const int borrow(const int cnt, Page* frames[]);
+  void giveBack(const int cnt, Page* const frames[]);
+
+  const MemStats getStats() const;
+  void clearStats();                    // zero the counts of grants
+
+ private:
+  mutable mutex latch;                  // guards stats
+  MemStats stats;
+};
+
+extern MemGovernor *memGov;
+
+
+// A MemGrant holds memory granted by the governor from construction
+// until it goes out of scope.
+
+class MemGrant
+{
+ public:
+  MemGrant(const int want, const int min)
+    : pages(memGov->grant(want, min)) {}
+  ~MemGrant() { memGov->release(pages); }
+  MemGrant(const MemGrant &) = delete;
+  MemGrant & operator=(const MemGrant &) = delete;
+
+  const int getPages() const { return pages; }
+
+ private:
+  const int pages;
+};
+
+
+// pages that hold the given number of bytes, rounded up
+inline int bytesToPages(const double bytes)
+{
+  const double maxPages = 1 << 30;
+  double pages = (bytes + PAGESIZE - 1) / PAGESIZE;
+  return pages < maxPages ? (int) pages : (int) maxPages;
+}
+
+#endif
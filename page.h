@@ -27,12 +27,36 @@ const unsigned DPFIXED= sizeof(slot_t)+4*sizeof(short)+2*sizeof(int);
 const unsigned PAGEDATASIZE = PAGESIZE-DPFIXED+sizeof(slot_t);
 // size of the data area of a page
 
+// format of the records on a page
+enum PageFormat { PLAINPAGE, COMPRESSEDPAGE, PAXPAGE };
+
 // Class definition for a minirel data page.   
 // The design assumes that records are kept compacted when
 // deletions are performed. Notice, however, that the slot
 // array cannot be compacted.  Notice, this class does not keep
 // the records align, relying instead on upper levels to take
 // care of non-aligned attributes
+//
+// A compressed page holds a header in slot 0 that describes how the
+// records in the other slots are encoded (see codec.h).  firstRecord
+// passes over the header and getRecord returns records as encoded;
+// the header is read with getHeader.
+//
+// A PAX page keeps fixed-length records grouped by attribute: the
+// values of each attribute lie one after the other in a minipage of
+// their own, and a bitmap tells which record numbers are in use.  The
+// slot number of a record is its number on the page.  The start of
+// data[] describes the layout:
+//
+//   attrCnt, capacity, recLen, recCnt : short(2) each
+//   for each attribute
+//     offset in record, length, offset of minipage : short(2) each
+//   bitmap : one bit per record, capacity bits
+//   minipages, each starting on a word boundary
+//
+// A record of a PAX page is not stored in one piece, so getRecord
+// does not apply; gatherRecord copies it out, and getAttr points at
+// one of its attributes in the minipage.
 
 class Page {
 private:
@@ -41,10 +65,29 @@ private:
     short	slotCnt; // number of slots in use;
     short	freePtr; // offset of first free byte in data[]
     short	freeSpace; // number of bytes free in data[]
-    short	dummy;	// for alignment purposes
+    short	format;	// a PageFormat
     int		nextPage; // forwards pointer
     int		curPage;  // page number of current pointer
 
+    // layout of a PAX page, at the start of data[]
+    struct PaxHeader {
+	short	attrCnt;  // attributes of a record
+	short	capacity; // records the page has room for
+	short	recLen;   // length of a record
+	short	recCnt;   // records on the page
+    };
+    struct PaxAttr {
+	short	offset;   // offset of attribute in a record
+	short	length;   // length of attribute
+	short	start;    // offset of its minipage in data[]
+    };
+
+    // true if record slotNo of a PAX page is in use
+    const bool paxUsed(const int slotNo) const;
+
+    // first record of a PAX page numbered slotNo or above
+    const Status paxNext(const int slotNo, RID & rid) const;
+
 public:
     void init(const int pageNo); // initialize a new page
     void dumpPage() const;       // dump contents of a page
@@ -53,12 +96,39 @@ public:
     const Status setNextPage(const int pageNo); // sets value of nextPage to pageNo
     const short getFreeSpace() const; // returns amount of free space
 
+    // makes an empty page a compressed page; the next record inserted
+    // is its header
+    void setCompressed();
+    const bool isCompressed() const { return format == COMPRESSEDPAGE; }
+
+    // returns reference to the header of a compressed page
+    const Status getHeader(Record & rec);
+
+    // makes an empty page a PAX page for records of recLen bytes made
+    // of attrCnt attributes; INVALIDRECLEN if not one of them fits
+    const Status setPax(const int attrCnt,
+			const int offsets[],
+			const int lengths[],
+			const int recLen);
+    const bool isPax() const { return format == PAXPAGE; }
+
+    // copies the record with RID rid of a PAX page into buf
+    const Status gatherRecord(const RID & rid, char *buf) const;
+
+    // returns pointer to attribute i of the record with RID rid of a
+    // PAX page
+    const Status getAttr(const RID & rid, const int i,
+			 const char *& attr) const;
+
     // inserts a new record (rec) into the page, returns RID of record 
     const Status insertRecord(const Record & rec, RID& rid);
 
     // delete the record with the specified rid
     const Status deleteRecord(const RID & rid);
 
+    // delete cnt records of the page, compacting it once
+    const Status deleteRecords(const RID rids[], const int cnt);
+
     // returns RID of first record on page
     // returns  NORECORDS if page contains no records.  Otherwise, returns OK
     const Status firstRecord(RID& firstRid) const;
@@ -56,11 +56,18 @@ typedef enum {
     N_DROP,
     N_LOAD,
     N_PRINT,
+    N_ANALYZE,
+    N_CLUSTER,
+    N_COMPRESS,
+    N_STATS,
+    N_EXPLAIN,
     N_HELP,
     N_SELECT,
     N_JOIN,
     N_PRIMATTR,
     N_QUALATTR,
+    N_AGGR,
+    N_ORDER,
     N_ATTRVAL,
     N_ATTRTYPE,
     N_VALUE,
@@ -82,12 +89,15 @@ typedef struct node {
 	    char *relname;
 	    struct node *attrlist;
 	    struct node *qual;
+	    struct node *groupby;	// grouping attributes, or NULL
+	    struct node *orderby;	// order node, or NULL
 	} QUERY;
 
 	// insert node */
 	struct {
 	    char *relname;
 	    struct node *attrlist;
+	    struct node *rows;		// value lists, one per row
 	} INSERT;
 
 	// delete node */
@@ -101,6 +111,7 @@ typedef struct node {
 	    char *relname;
 	    struct node *attrlist;
 	    struct node *primattr;
+	    char *layout;
 	} CREATE;
 
 	// destroy node */
@@ -132,6 +143,34 @@ typedef struct node {
 	    char *relname;
 	} PRINT;
 
+	// analyze node */
+	struct {
+	    char *relname;
+	} ANALYZE;
+
+	// cluster node */
+	struct {
+	    char *relname;
+	    char *attrname;
+	    int fillfactor;
+	} CLUSTER;
+
+	// compress node */
+	struct {
+	    char *relname;
+	} COMPRESS;
+
+	// stats node */
+	struct {
+	    char *option;
+	} STATS;
+
+	// explain node */
+	struct {
+	    char *option;
+	    struct node *query;
+	} EXPLAIN;
+
 	// help node */
 	struct {
 	    char *relname;
@@ -157,6 +196,20 @@ typedef struct node {
 	    char *attrname;
 	} QUALATTR;
 
+	// aggregate node */
+	struct {
+	    int func;			// an AggFunc
+	    struct node *attr;		// qualified attribute, whose attrname
+					// is NULL for count(*)
+	} AGGR;
+
+	// order by node */
+	struct {
+	    struct node *attr;		// qualified attribute to order by
+	    int desc;			// largest value first
+	    int limit;			// most tuples returned, -1 for all
+	} ORDER;
+
 	// primary attribute node */
 	struct {
 	    char *attrname;
@@ -212,20 +265,29 @@ typedef struct node {
 //
 
 NODE *newnode(int kind);
-NODE *query_node(char *relname, NODE *attrlist, NODE *n);
-NODE *insert_node(char *relname, NODE *attrlist);
+NODE *query_node(char *relname, NODE *attrlist, NODE *n, NODE *groupby,
+		  NODE *orderby);
+NODE *insert_node(char *relname, NODE *attrlist, NODE *rows);
 NODE *delete_node(char *relname, NODE *qual);
-NODE *create_node(char *relname, NODE *attrlist, NODE *primattr);
+NODE *create_node(char *relname, NODE *attrlist, NODE *primattr,
+		  char *layout);
 NODE *destroy_node(char *relname);
 NODE *build_node(char *relname, char *attrname, int nbuckets);
 NODE *rebuild_node(char *relname, char *attrname, int nbuckets);
 NODE *drop_node(char *relname, char *attrname);
 NODE *load_node(char *relname, char *filename);
 NODE *print_node(char *relname);
+NODE *analyze_node(char *relname);
+NODE *cluster_node(char *relname, char *attrname, int fillfactor);
+NODE *compress_node(char *relname);
+NODE *stats_node(char *option);
+NODE *explain_node(char *option, NODE *query);
 NODE *help_node(char *relname);
 NODE *select_node(NODE *selattr, int op, NODE *value);
 NODE *join_node(NODE *joinattr1, int op, NODE *joinattr2);
 NODE *qualattr_node(char *relname, char *attrname);
+NODE *aggr_node(int func, NODE *attr);
+NODE *order_node(NODE *attr, int desc, int limit);
 NODE *primattr_node(char *attrname, int nbuckets);
 NODE *attrval_node(char *attrname, NODE *value);
 //attrtype_node need to change due to change of NODE.ATTRTYPE
@@ -235,6 +297,7 @@ NODE *float_node(float rval);
 NODE *string_node(char *s);
 NODE *list_node(NODE *n);
 NODE *prepend(NODE *n, NODE *list);
+NODE *reverse(NODE *list);
 NODE *merge_attr_value_list(NODE *attr_list, NODE *value_list);
 NODE *alias_node(char *relname, char *alias);
 NODE *replace_alias_in_qualattr_list(NODE *alias, NODE *qualattr_list);
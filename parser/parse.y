@@ -5,6 +5,8 @@
 
 #include <stdlib.h>
 #include "heapfile.h"
+#include "catalog.h"
+#include "query.h"
 #include "parse.h"
 #include "stdio.h"
 
@@ -17,6 +19,8 @@ extern void quit();
 void yyerror(char *);
 
 extern char *yytext;                    // tokens in string format
+extern FILE *yyin;                      // input of the scanner
+extern void yyrestart(FILE *);
 static NODE *parse_tree;                // root of parse tree
 %}
 
@@ -72,10 +76,33 @@ static NODE *parse_tree;                // root of parse tree
 		T_QSTRING
 		T_SHELL_CMD
 
+%token		RW_ANALYZE
+		RW_STATS
+		RW_EXPLAIN
+		RW_CLUSTER
+		RW_ON
+		RW_FILLFACTOR
+		RW_COMPRESS
+		RW_LAYOUT
+		RW_GROUP
+		RW_BY
+		RW_COUNT
+		RW_SUM
+		RW_MIN
+		RW_MAX
+		RW_AVG
+		RW_ORDER
+		RW_DESC
+		RW_LIMIT
+
 %type	<ival>	op
+		aggfunc
+		opt_desc
+		opt_limit
 
 %type	<sval>	opt_into_relname
 		opt_relname
+		opt_layout
 		string
 
 %type	<n>	command
@@ -91,6 +118,11 @@ static NODE *parse_tree;                // root of parse tree
 		drop
 		load
 		print
+		analyze
+		cluster
+		compress
+		stats
+		explain
 		help
 		quit
 		opt_primary_attr
@@ -100,6 +132,11 @@ static NODE *parse_tree;                // root of parse tree
 		join
 		non_mt_qualattr_list
 		qualattr
+		select_list
+		select_item
+		aggr
+		opt_group_by
+		opt_order_by
 /*
 		non_mt_attrval_list
 		attrval
@@ -110,6 +147,7 @@ static NODE *parse_tree;                // root of parse tree
 		attrib
 		attrib_list
 		value_list
+		value_rows
 		val
 		table_list
 		table
@@ -154,6 +192,11 @@ command
 	| drop
 	| load
 	| print
+	| analyze
+	| cluster
+	| compress
+	| stats
+	| explain
 	| help
 	| quit
 	| nothing
@@ -163,13 +206,21 @@ command
 	;
 
 query
-	: RW_SELECT non_mt_qualattr_list opt_into_relname RW_FROM table_list opt_where
+	: RW_SELECT select_list opt_into_relname RW_FROM table_list opt_where opt_group_by opt_order_by
 /*	RW_SELECT opt_into_relname '(' non_mt_qualattr_list ')' opt_where */
 	{
 		NODE *where;
+		NODE *groupby = NULL;
+		NODE *orderby = NULL;
 		NODE *qualattr_list = replace_alias_in_qualattr_list($5, $2);
-		if (qualattr_list == NULL) { // something wrong in qualattr_list
-		  $$ = NULL;
+		if ($7 != NULL)
+		  groupby = replace_alias_in_qualattr_list($5, $7);
+		if ($8 != NULL)
+		  orderby = replace_alias_in_qualattr_list($5,
+					list_node($8->u.ORDER.attr));
+		if (qualattr_list == NULL || ($7 != NULL && groupby == NULL) ||
+		    ($8 != NULL && orderby == NULL)) {
+		  $$ = NULL; // something wrong in qualattr_list
 		}
 		else {
 		  where = replace_alias_in_condition($5, $6);
@@ -177,12 +228,110 @@ query
 		     $$ = NULL; //something wrong in where condition
 		  }
 		  else {
-		    $$ = query_node($3, qualattr_list, where);
+		    $$ = query_node($3, qualattr_list, where, groupby, $8);
 		  }
 		}
 	}
 	;
 
+select_list
+	: '(' select_list ')'
+	{
+		$$ = $2;
+	}
+	| select_item ',' select_list
+	{
+		$$ = prepend($1, $3);
+	}
+	| select_item
+	{
+		$$ = list_node($1);
+	}
+	;
+
+select_item
+	: qualattr
+	| aggr
+	;
+
+aggr
+	: RW_COUNT '(' '*' ')'
+	{
+		$$ = aggr_node(AGGCOUNT, qualattr_node(NULL, NULL));
+	}
+	| RW_COUNT '(' qualattr ')'
+	{
+		$$ = aggr_node(AGGCOUNT, $3);
+	}
+	| aggfunc '(' qualattr ')'
+	{
+		$$ = aggr_node($1, $3);
+	}
+	;
+
+aggfunc
+	: RW_SUM
+	{
+		$$ = AGGSUM;
+	}
+	| RW_MIN
+	{
+		$$ = AGGMIN;
+	}
+	| RW_MAX
+	{
+		$$ = AGGMAX;
+	}
+	| RW_AVG
+	{
+		$$ = AGGAVG;
+	}
+	;
+
+opt_group_by
+	: RW_GROUP RW_BY non_mt_qualattr_list
+	{
+		$$ = $3;
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
+
+opt_order_by
+	: RW_ORDER RW_BY qualattr opt_desc opt_limit
+	{
+		$$ = order_node($3, $4, $5);
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
+
+opt_desc
+	: RW_DESC
+	{
+		$$ = 1;
+	}
+	| nothing
+	{
+		$$ = 0;
+	}
+	;
+
+opt_limit
+	: RW_LIMIT T_INT
+	{
+		$$ = $2;
+	}
+	| nothing
+	{
+		$$ = -1;
+	}
+	;
+
 table_list
 	: '(' table_list ')'
 	{
@@ -208,11 +357,31 @@ table
 	}
 
 insert
-	: RW_INSERT RW_INTO string '(' attrib_list ')' RW_VALUES '(' value_list ')' 
-	{
-		NODE* tmp = merge_attr_value_list($5, $9);
+	: RW_INSERT RW_INTO string '(' attrib_list ')' RW_VALUES value_rows
+	{
+		// check every row against the attributes, then leave
+		// the values of the first row in the attribute list
+		NODE* rows = reverse($8);
+		NODE* tmp = $5;
+		for (NODE* r = rows; r != NULL && tmp != NULL;
+		     r = r->u.LIST.next)
+			tmp = merge_attr_value_list($5, r->u.LIST.self);
+		if (tmp != NULL)
+			tmp = merge_attr_value_list($5, rows->u.LIST.self);
 		if (tmp == NULL) $$=NULL;
-		else $$ = insert_node($3, tmp);
+		else $$ = insert_node($3, tmp, rows);
+	}
+	;
+
+/* rows are collected in reverse so that long inserts don't grow the stack */
+value_rows
+	: value_rows ',' '(' value_list ')'
+	{
+		$$ = prepend($4, $1);
+	}
+	| '(' value_list ')'
+	{
+		$$ = list_node($2);
 	}
 	;
 
@@ -257,8 +426,9 @@ delete
 
 create
 	: RW_CREATE RW_TABLE string '(' non_mt_attrtype_list ')' opt_primary_attr
+	  opt_layout
 	{
-		$$ = create_node($3, $5, $7);
+		$$ = create_node($3, $5, $7, $8);
 	}
 	;
 
@@ -309,6 +479,53 @@ print
 	}
 	;
 
+analyze
+	: RW_ANALYZE string
+	{
+		$$ = analyze_node($2);
+	}
+	;
+
+cluster
+	: RW_CLUSTER string RW_ON string
+	{
+		$$ = cluster_node($2, $4, 100);
+	}
+	| RW_CLUSTER string RW_ON string RW_FILLFACTOR T_EQ T_INT
+	{
+		$$ = cluster_node($2, $4, $7);
+	}
+	;
+
+compress
+	: RW_COMPRESS string
+	{
+		$$ = compress_node($2);
+	}
+	;
+
+stats
+	: RW_STATS
+	{
+		$$ = stats_node(NULL);
+	}
+	| RW_STATS string
+	{
+		$$ = stats_node($2);
+	}
+	;
+
+explain
+	: RW_EXPLAIN RW_ANALYZE query
+	{
+		$$ = explain_node(NULL, $3);
+	}
+	| RW_EXPLAIN RW_ANALYZE string query
+	{
+		$$ = explain_node($3, $4);
+	}
+	;
+
 help
 	: RW_HELP opt_relname
 	{
@@ -334,6 +551,17 @@ opt_primary_attr
 	}
 	;
 
+opt_layout
+	: RW_LAYOUT string
+	{
+		$$ = $2;
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
+
 opt_into_relname
 	: RW_INTO string
 	{
@@ -519,6 +747,8 @@ void parse(void)
 {
   extern void new_query();
   extern void interp(NODE *);
+  extern void UT_TraceBegin(void);
+  extern void UT_TraceEnd(void);
 
   for(;;){
 
@@ -530,12 +760,41 @@ void parse(void)
     fflush(stdout);
 
     // if a query was successfully read, interpret it
-    if(yyparse() == 0 && parse_tree != NULL)
+    if(yyparse() == 0 && parse_tree != NULL) {
+      UT_TraceBegin();
       interp(parse_tree);
+      UT_TraceEnd();
+    }
   }
 }
 
 
+//
+// parse_statement: parses one statement, ended by a semicolon, held in
+// text rather than read from yyin; for server sessions, which read
+// their statements themselves.  The parse tree is built in the nodes of
+// the calling thread and lasts until its next new_query.  The scanner
+// and parser are shared, so callers must parse one at a time.
+//
+// Returns the parse tree, or NULL if the statement was empty or wrong.
+//
+
+NODE *parse_statement(const char *text)
+{
+  FILE *in = fmemopen((void *) text, strlen(text), "r");
+  if (in == NULL)
+    return NULL;
+
+  FILE *saved = yyin;
+  yyrestart(in);
+  parse_tree = NULL;
+  NODE *n = (yyparse() == 0) ? parse_tree : NULL;
+  fclose(in);
+  yyin = saved;
+  return n;
+}
+
+
 void yyerror(char *s)
 {
   puts(s);
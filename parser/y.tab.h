@@ -78,7 +78,25 @@
      T_REAL = 294,
      T_STRING = 295,
      T_QSTRING = 296,
-     T_SHELL_CMD = 297
+     T_SHELL_CMD = 297,
+     RW_ANALYZE = 298,
+     RW_STATS = 299,
+     RW_EXPLAIN = 300,
+     RW_CLUSTER = 301,
+     RW_ON = 302,
+     RW_FILLFACTOR = 303,
+     RW_COMPRESS = 304,
+     RW_LAYOUT = 305,
+     RW_GROUP = 306,
+     RW_BY = 307,
+     RW_COUNT = 308,
+     RW_SUM = 309,
+     RW_MIN = 310,
+     RW_MAX = 311,
+     RW_AVG = 312,
+     RW_ORDER = 313,
+     RW_DESC = 314,
+     RW_LIMIT = 315
    };
 #endif
 /* Tokens.  */
@@ -122,6 +140,24 @@
 #define T_STRING 295
 #define T_QSTRING 296
 #define T_SHELL_CMD 297
+#define RW_ANALYZE 298
+#define RW_STATS 299
+#define RW_EXPLAIN 300
+#define RW_CLUSTER 301
+#define RW_ON 302
+#define RW_FILLFACTOR 303
+#define RW_COMPRESS 304
+#define RW_LAYOUT 305
+#define RW_GROUP 306
+#define RW_BY 307
+#define RW_COUNT 308
+#define RW_SUM 309
+#define RW_MIN 310
+#define RW_MAX 311
+#define RW_AVG 312
+#define RW_ORDER 313
+#define RW_DESC 314
+#define RW_LIMIT 315
 
 
 
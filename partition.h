@@ -2,6 +2,7 @@
 #define PARTITION_H
 
 #include "heapfile.h"
+#include "tempspace.h"
 
 
 // define if debug output wanted
@@ -16,14 +17,14 @@ class Partition {
 	    const int (*hashfcn)(const Record & rec,
 				 const int P),  
 	                               // hash function to use in partitioning
-	    string* &partName,           // names of partitioned heap files
+	    TempFile** &part,            // partitions in the temp space
 	    Status &status);            // create partitions of file
   ~Partition();                         // destroy partitions
 
  private:
 
   int P;                                // number of partitions
-  string *partName;                      // partition names
+  TempFile **part;                      // partitions
 };
 
 #endif
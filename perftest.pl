@@ -0,0 +1,140 @@
+#!/usr/bin/perl
+#
+# perftest.pl: end-to-end query benchmark driver
+#
+# Generates Wisconsin style relations R (n tuples) and S (n/10 tuples)
+# with data/genWisconsin, then for every combination of join method
+# and buffer pool size creates a fresh database, loads R and S and
+# runs the select and join workloads below under explain analyze.
+# One CSV line per workload and run is appended to the output file:
+#
+#   rows,theta,dupratio,method,buffers,workload,ms,diskreads,diskwrites
+#
+# The workload "total" covers the whole minirel run including the
+# loads; its time is wall clock time and its I/O comes from "stats".
+#
+# Usage: perftest.pl [-n rows] [-z theta] [-d ratio] [-m methods]
+#                    [-b buffers] [-o file]
+#
+#   -n rows      tuples in R (default 100000)
+#   -z theta     Zipf skew of S.skewed (default 0)
+#   -d ratio     duplicate ratio of S.skewed (default 0)
+#   -m methods   comma separated join methods (default SM,HJ,AUTO;
+#                NL is quadratic, only use it for small n)
+#   -b buffers   comma separated buffer pool sizes (default 100)
+#   -o file      CSV file to append to (default perf.csv)
+#
+
+use strict;
+use Getopt::Std;
+use Time::HiRes qw(time);
+
+my %opts;
+getopts("n:z:d:m:b:o:", \%opts) or die "usage: $0 [-n rows] [-z theta] "
+    . "[-d ratio] [-m methods] [-b buffers] [-o file]\n";
+
+my $rows = $opts{n} || 100000;
+my $theta = $opts{z} || 0;
+my $dupRatio = $opts{d} || 0;
+my @methods = split(/,/, $opts{m} || "SM,HJ,AUTO");
+my @bufSizes = split(/,/, $opts{b} || "100");
+my $csv = $opts{o} || "perf.csv";
+
+my $DATADIR = "./data";
+my $GEN = "$DATADIR/genWisconsin";
+my $TESTDB = "perfdb";
+
+my $schema = "unique1 int, unique2 int, two int, four int, ten int, "
+    . "twenty int, onePercent int, tenPercent int, twentyPercent int, "
+    . "fiftyPercent int, unique3 int, evenOnePercent int, "
+    . "oddOnePercent int, skewed int, stringu1 char(52), "
+    . "stringu2 char(52), string4 char(52)";
+
+# the workloads, in the style of the test queries
+my $one = int($rows / 100);
+my @workloads = (
+    [ "select_1pct",
+      "select R.unique1, R.stringu1 into res from R where R.onePercent = 7" ],
+    [ "select_10pct",
+      "select R.unique1, R.stringu1 into res from R where R.tenPercent = 3" ],
+    [ "select_range_1pct",
+      "select R.unique1, R.unique2 into res from R where R.unique2 < $one" ],
+    [ "join_unique",
+      "select R.unique1, S.unique2 into res from R, S "
+      . "where R.unique1 = S.unique1" ],
+    [ "join_skewed",
+      "select R.unique1, S.unique2 into res from R, S "
+      . "where R.unique1 = S.skewed" ],
+);
+
+(system("make -s minirel dbcreate dbdestroy $GEN") == 0)
+    or die "build failed\n";
+
+# generate the data files unless they already exist
+my $sRows = int($rows / 10) || 1;
+my $tag = "${rows}_z${theta}_d${dupRatio}";
+my $rFile = "$DATADIR/wisc_${rows}_R.data";
+my $sFile = "$DATADIR/wisc_${tag}_S.data";
+(-r $rFile || system("$GEN -s 1 $rows $rFile") == 0)
+    or die "cannot generate $rFile\n";
+(-r $sFile || system("$GEN -s 2 -z $theta -d $dupRatio $sRows $sFile") == 0)
+    or die "cannot generate $sFile\n";
+
+# write the query file
+my $queries = "/tmp/perftest.$$";
+open(QUERIES, "> $queries") || die "cannot create $queries\n";
+print QUERIES "create table R ($schema);\n";
+print QUERIES "load table R from (\"../$rFile\");\n";
+print QUERIES "create table S ($schema);\n";
+print QUERIES "load table S from (\"../$sFile\");\n";
+foreach my $w (@workloads) {
+    print QUERIES "explain analyze json $w->[1];\n";
+    print QUERIES "destroy table res;\n";
+}
+print QUERIES "stats json;\n";
+close(QUERIES);
+
+my $newFile = ! -e $csv;
+open(CSV, ">> $csv") || die "cannot open $csv\n";
+print CSV "rows,theta,dupratio,method,buffers,workload,ms,diskreads,"
+    . "diskwrites\n" if $newFile;
+
+foreach my $bufs (@bufSizes) {
+    foreach my $method (@methods) {
+	system("echo y | ./dbdestroy $TESTDB > /dev/null 2>&1");
+	(system("./dbcreate $TESTDB > /dev/null") == 0)
+	    or die "cannot create $TESTDB\n";
+
+	my $start = time();
+	open(OUT, "./minirel $TESTDB $method $bufs < $queries 2>&1 |")
+	    || die "cannot run minirel\n";
+
+	# each explain prints one JSON line whose outermost phase is
+	# the query; stats prints the totals last
+	my $i = 0;
+	my ($reads, $writes) = ("", "");
+	while (<OUT>) {
+	    if (/^\{"phase":"query".*?"timeMs":([0-9.]+).*?"reads":(\d+),"writes":(\d+)/) {
+		my $name = $i < @workloads ? $workloads[$i][0] : "query$i";
+		print CSV "$rows,$theta,$dupRatio,$method,$bufs,$name,"
+		    . "$1,$2,$3\n";
+		$i++;
+	    }
+	    elsif (/"io":\{"reads":(\d+),"writes":(\d+)/) {
+		($reads, $writes) = ($1, $2);
+	    }
+	}
+	close(OUT);
+	my $ms = sprintf("%.3f", (time() - $start) * 1000);
+
+	print STDERR "$method, $bufs buffers: $i of " . scalar(@workloads)
+	    . " workloads completed\n" if $i != @workloads;
+	print CSV "$rows,$theta,$dupRatio,$method,$bufs,total,$ms,"
+	    . "$reads,$writes\n";
+	print "$method, $bufs buffers: $ms ms\n";
+    }
+}
+
+close(CSV);
+system("echo y | ./dbdestroy $TESTDB > /dev/null 2>&1");
+unlink($queries);
@@ -3,7 +3,25 @@
 
 #include "heapfile.h"
 
-enum JoinType {NLJoin, SMJoin, HashJoin};
+enum JoinType {NLJoin, SMJoin, HashJoin, BandJoin, AutoJoin, ParHashJoin};
+
+// aggregate functions of a select; AGGNONE marks a grouping attribute
+// in the select list
+enum AggFunc {AGGNONE, AGGCOUNT, AGGSUM, AGGMIN, AGGMAX, AGGAVG};
+
+// result of costing a join.  cost[] holds the estimated number of
+// page I/Os for each of NLJoin, SMJoin, HashJoin and BandJoin
+// (negative if the method cannot evaluate the join predicate)
+
+struct JoinPlan
+{
+  JoinType method;      // cheapest applicable join method
+  double cost[4];       // estimated page I/Os, indexed by JoinType
+  double resultCard;    // estimated number of result tuples
+  int pageCnt1, pageCnt2;   // data pages of the two input relations
+  int recCnt1, recCnt2;     // records in the two input relations
+  double distinct1, distinct2; // estimated distinct join attribute values
+};
 
 //
 // Prototypes for query layer functions
@@ -15,7 +33,17 @@ const Status QU_Select(const string & result,
 		       const attrInfo projNames[],
 		       const attrInfo *attr, 
 		       const Operator op, 
-		       const char *attrValue);
+		       const char *attrValue,
+		       const attrInfo *orderAttr = NULL,  // output order
+		       const bool desc = false,           // largest first
+		       const int limit = -1);             // most tuples, or -1
+
+// true if the attribute of the record satisfies `attr op filter',
+// compared as a filtered HeapFileScan compares them
+const bool QU_Match(const char *data,
+		    const AttrDesc & attr,
+		    const Operator op,
+		    const char *filter);
 
 const Status QU_Join(const string & result, 
 		     const int projCnt, 
@@ -24,10 +52,34 @@ const Status QU_Join(const string & result,
 		     const Operator op, 
 		     const attrInfo *attr2);
 
+const Status QU_PlanJoin(const int projCnt,
+			 const attrInfo projNames[],
+			 const attrInfo *attr1,
+			 const Operator op,
+			 const attrInfo *attr2,
+			 JoinPlan & plan);
+
+void QU_PrintPlan(const JoinPlan & plan,
+		  const attrInfo *attr1,
+		  const Operator op,
+		  const attrInfo *attr2);
+
+const Status QU_Aggregate(const string & result,
+			  const int projCnt,
+			  const attrInfo projNames[],
+			  const AggFunc funcs[],
+			  const int groupCnt,
+			  const attrInfo groupNames[],
+			  const attrInfo *attr,
+			  const Operator op,
+			  const char *attrValue);
+
 const Status QU_Insert(const string & relation, 
 		       const int attrCnt, 
 		       const attrInfo attrList[]);
 
+const Status QU_InsertFlush();
+
 const Status QU_Delete(const string & relation, 
 		       const string & attrName, 
 		       const Operator op,
@@ -0,0 +1,87 @@
+#ifndef RELCACHE_H
+#define RELCACHE_H
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include "page.h"
+#include "buf.h"
+
+using namespace std;
+
+// define if debug output wanted
+//#define DEBUGRELCACHE
+
+
+// heap files kept open by the cache while no HeapFile uses them
+const int RELCACHESIZE = 8;
+
+struct FileHdrPage;
+
+
+// What a HeapFile needs of an open heap file: the File, its header
+// page, pinned in the buffer pool for as long as the handle lives,
+// and the File of its zone map.  A handle is shared by all HeapFiles
+// open on the same file.
+
+struct RelHandle
+{
+  string	name;		// name of the heap file
+  File*		filePtr;	// the heap file
+  FileHdrPage*	headerPage;	// its pinned header page
+  int		headerPageNo;	// page number of the header page
+  PageHandle	header;		// pin on the header page, set dirty
+				// when a HeapFile updated it
+  File*		zoneFile;	// zone map file, NULL if none
+  int		refCnt;		// HeapFiles using the handle
+  list<RelHandle*>::iterator lru; // place in the LRU list, if unused
+};
+
+
+// The relation cache keeps heap files open across operations, so
+// that opening one that was used lately is a lookup of its name
+// rather than a Unix open and the reading and pinning of its header
+// page; the pages of a file also stay in the buffer pool, which
+// flushes them when the file is closed.  Handles no HeapFile uses are
+// kept in least recently used order, RELCACHESIZE of them at most.
+//
+// A file must be out of the cache to be destroyed or renamed; evict
+// takes it out, and fails with FILEOPEN while a HeapFile uses it.
+// Server sessions share the cache; the latch serializes its methods.
+
+class RelCache {
+ public:
+  RelCache();
+  ~RelCache();
+
+  // handle of heap file name, opening the file unless it is cached
+  const Status open(const string & name, RelHandle *& handle);
+
+  // done with a handle returned by open
+  void close(RelHandle *handle);
+
+  // close heap file name if it is cached
+  const Status evict(const string & name);
+
+  // close all heap files no HeapFile uses, before the buffer manager
+  // goes away
+  void clear();
+
+  const int getHits() const { return hits; }
+  const int getMisses() const { return misses; }
+
+ private:
+  const Status drop(RelHandle *handle);   // close an unused handle
+  void trim();                            // drop unused ones past the limit
+
+  map<string, RelHandle*> handles;        // cached handles by file name
+  list<RelHandle*> unused;                // unused ones, most recent first
+  int hits;                               // opens found in the cache
+  int misses;                             // opens that opened the file
+  mutex latch;                            // guards all of the above
+};
+
+extern RelCache *relCache;
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include "error.h"
+
+using namespace std;
+
+// define if debug output wanted
+//#define DEBUGSERVER
+
+
+// Unix domain socket a server listens on, in the database directory
+#define SERVERSOCKET "minirel.sock"
+
+// worker threads, each serving one client session at a time; clients
+// that connect while all are busy wait for one to finish
+const int SERVERTHREADS = 8;
+
+// connections the kernel queues before they are accepted
+const int SERVERBACKLOG = 64;
+
+// bytes of output a session collects before sending them to its client
+const int SESSIONBUFSIZE = 8192;
+
+
+// The lock table keeps server sessions from using a relation while
+// another changes it.  Any number of statements may read a relation at
+// once, and one may change it while no other uses it.  A statement
+// takes the locks on all its relations before it starts, in order of
+// their names, and holds them until it ends, so statements cannot
+// deadlock; a statement waiting to change a relation holds off new
+// readers of it.
+
+class LockTable
+{
+ public:
+  // waits for and takes locks on the relations in reads, shared, and
+  // those in writes, exclusive
+  void lock(const set<string> & reads, const set<string> & writes);
+
+  // releases the locks taken by lock with the same sets
+  void unlock(const set<string> & reads, const set<string> & writes);
+
+ private:
+  struct RelLock
+  {
+    int readers;                        // statements reading the relation
+    bool writer;                        // a statement is changing it
+    int readersWaiting;                 // statements waiting to read it
+    int writersWaiting;                 // statements waiting to change it
+  };
+
+  mutex latch;                          // guards locks
+  condition_variable released;          // signalled when locks are released
+  map<string, RelLock> locks;           // locks in use or waited for
+};
+
+
+// Serves clients on socket socketName with the given number of worker
+// threads until the process gets SIGINT or SIGTERM.  Each client is a
+// session that sends statements as they would be typed to minirel and
+// gets back what minirel would print.  All sessions share the buffer
+// pool, relation cache and catalogs.
+const Status UT_Serve(const string & socketName, const int threads);
+
+// Sends standard input to the server on socketName and copies what it
+// sends back to standard output, until the server closes the session.
+const Status UT_Connect(const string & socketName);
+
+#endif
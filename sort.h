@@ -2,12 +2,18 @@
 #define SORT_H
 
 #include "heapfile.h"
+#include "tempspace.h"
 
 // define if debug output wanted
 //#define DEBUGSORT
 
 
-// SORTREC is an in-memory sort record that qsort(3) sorts.
+// least number of records sorted in memory per run by QU_SM_Join;
+// runs are longer when the memory governor grants more
+const int SMMAXITEMS = 1000;
+
+
+// SORTREC is an in-memory sort record that a run is sorted in.
 // The sort attribute as well as the associated RID are
 // stored in the record. The RID is used for fetching the
 // full record when it is needed.
@@ -19,12 +25,30 @@ typedef struct {
 } SORTREC;
 
 
+// SortPredicate is a selection the records of the source file must
+// satisfy to be sorted, as HeapFileScan::startScan takes it.  The value
+// must outlive the SortedFile.
+
+struct SortPredicate {
+  int offset;                           // offset of the attribute
+  int length;                           // length of the attribute
+  Datatype type;                        // type of the attribute
+  const char* value;                    // value compared with
+  Operator op;                          // `attribute op value' must hold
+};
+
+
 class SortedFile {
  public:
   SortedFile(const string & fileName, 
 	     int offset,// sort source file on the given
 	     int length, Datatype type, // attribute
-	     int maxItems, Status& status);
+	     int maxItems, Status& status,
+	     RuntimeFilter* keys = NULL,  // collects the sort attribute
+	     RuntimeFilter* filter = NULL, // drops records while reading
+	     bool sorted = false,         // source already in sort order
+	     bool descending = false,     // largest value first
+	     const SortPredicate* pred = NULL); // selects the records sorted
 
   Status next(Record & rec);            // fetch next record in sort order
   Status setMark();                     // record a position in sort sequence
@@ -35,11 +59,12 @@ class SortedFile {
   Status sortFile();                    // split source file into sub-runs
   Status generateRun(int numItems);     // generate one sub-run of file
   Status startScans();                  // start a scan on each sorted run
+  Status useSource();                   // make the source the only run
+  Status startSource(HeapFileScan* scan); // scan the source, selecting
 
   typedef struct {
-    string name;                        // name of run file
-    HeapFileScan* inFile;               // ptr to input file
-    InsertFileScan* outFile;		// ptr to output file
+    TempFile* temp;                     // sorted run, or NULL
+    HeapFileScan* inFile;               // scan of source file as the run
     int valid;                          // TRUE if recPtr has a record
     Record rec;
     RID rid;                            // RID of current record of run
@@ -54,6 +79,13 @@ class SortedFile {
   Datatype type;                        // type of sort attribute
   int offset;                           // offset of sort attribute
   int length;                           // length of sort attribute
+  RuntimeFilter* keys;                  // filter to add sort keys to
+  RuntimeFilter* filter;                // filter applied to source file
+  bool sorted;                          // source file is the only run
+  bool descending;                      // records come largest first
+  bool selected;                        // only records of pred are sorted
+  SortPredicate pred;                   // selection on the source file
+  AttrCmpFn cmpFn;                      // compares values of the attribute
 
   SORTREC* buffer;                      // in-memory sort buffer
   int maxItems;                         // max. # of items/tuples in buffer
@@ -0,0 +1,129 @@
+#ifndef TEMPSPACE_H
+#define TEMPSPACE_H
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+#include "page.h"
+
+using namespace std;
+
+// define if debug output wanted
+//#define DEBUGTEMP
+
+
+// pages of temporary files kept in memory before they spill, unless
+// the memory governor grants more
+const int TEMPPAGES = 256;
+
+// pages written to or read from the scratch file at a time
+const int SPILLPAGES = 32;
+
+// pages the scratch file grows by when it runs out of room
+const int SCRATCHEXTENT = 256;
+
+
+// A TempFile is an anonymous sequence of pages that an operator
+// appends records to and then scans, for sorted runs and partitions.
+// It is not a relation and its pages never enter the buffer pool: they
+// are kept in memory as long as all temporary files together hold no
+// more than the cap of the temp space, and are written to its scratch
+// file, SPILLPAGES at a time, beyond it.  A record is known by its RID,
+// the number of its page in the file and its slot on the page.
+//
+// A record returned by scanNext or getRecord stays where it is until
+// the next call on the same file.
+
+class TempFile {
+  friend class TempSpace;
+
+ public:
+  TempFile();                            // empty file in tempSpace
+  ~TempFile();                           // releases its pages
+
+  // appends a record; INVALIDRECLEN if it does not fit on a page
+  const Status insertRecord(const Record & rec, RID & rid);
+
+  const Status startScan();               // scan from the first record
+  const Status scanNext(RID & rid);       // next record, FILEEOF at end
+  const Status getRecord(Record & rec);   // the current record
+  const Status markScan();                // remember the current record
+  const Status resetScan();               // go back to the one remembered
+
+  const int getPageCnt() const { return pages.size(); }
+  const int getRecCnt() const { return recCnt; }
+
+ private:
+  struct TempPage {
+    Page *page;                           // in memory, or NULL
+    int spillNo;                          // page of scratch file, or -1
+  };
+
+  const Status spill(const int cnt);      // writes out the first cnt
+                                          // pages kept in memory
+  const Status fetch(const int pageNo, Page *& page);
+
+  vector<TempPage> pages;
+  int memCnt;                             // pages kept in memory
+  int recCnt;                             // records appended
+  RID curRid;                             // current record of the scan
+  RID markRid;
+  Page *readBuf;                          // spilled pages read back
+  int readFirst;                          // first page in readBuf
+  int readCnt;                            // pages in readBuf
+};
+
+
+// The temp space keeps count of the pages temporary files hold in
+// memory and owns the scratch file they spill to.  The scratch file is
+// created in the database directory on the first spill and unlinked at
+// once, so it goes away with the process; it grows SCRATCHEXTENT pages
+// at a time and the space of a temporary file is reused once it is
+// destroyed.  The pages up to the cap are granted by the memory
+// governor, and those granted past the initial cap are given back as
+// temporary files go away.  When the governor grants less than the
+// temp space asks for, it borrows frames of the buffer pool for the
+// rest and keeps pages of temporary files in them; those are used
+// first, and given back when a temporary file goes away.  Queries of several server sessions
+// share it: the page counts are atomic and the latch guards the
+// scratch file's free runs, the frames borrowed and the pages granted.
+
+class TempSpace {
+  friend class TempFile;
+
+ public:
+  TempSpace(const int maxPages);          // initial cap on pages in memory
+  ~TempSpace();
+
+  const int getMemPages() const { return memPages; }
+  const int getSpilled() const { return spilled; }
+  const int getMaxPages() const { return maxPages; }
+
+ private:
+  const bool grow();                      // raise the cap, if granted
+  void shrink();                          // give back what is unused
+  Page *newPage();                        // a page for a temporary file
+  void freePage(Page *page);              // and back
+  const Status allocate(const int cnt, int & spillNo);
+  void release(const int spillNo, const int cnt);
+  const Status write(const int spillNo, Page *pages[], const int cnt);
+  const Status read(const int spillNo, Page *pages, const int cnt);
+
+  atomic<int> maxPages;                   // cap on pages in memory
+  atomic<int> memPages;                   // pages in memory, all files
+  atomic<int> spilled;                    // pages written to scratch
+  int minPages;                           // initial cap
+  int scratch;                            // unix file, -1 until needed
+  int scratchPages;                       // pages preallocated
+  int endPage;                            // pages handed out so far
+  map<int, int> freeRuns;                 // free page runs: start, length
+  int borrowed;                           // frames borrowed of the pool
+  vector<Page *> lentFree;                // those not holding a page
+  mutex latch;                            // guards the six above and
+                                          // changes of the cap
+};
+
+extern TempSpace *tempSpace;
+
+#endif
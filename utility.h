@@ -27,6 +27,31 @@ const Status UT_Load(const string & relation,
 
 const Status UT_Print(string relation);
 
+const Status UT_Analyze(const string & relation);
+
+float  UT_statKey(const char *value, const int type);
+
+const Status UT_Stats(const string & option);
+
+const Status UT_Cluster(const string & relation,
+			const string & attrName,
+			const int fillFactor);
+
+const Status UT_ReplaceFile(const string & relation,
+			    const string & newName);
+
+const Status UT_Compress(const string & relation);
+
+const Status UT_BuildZoneMap(const string & relation,
+			     const string & attrName);
+
+const Status UT_DropZoneMap(const string & relation,
+			    const string & attrName);  // all if empty
+
+void   UT_TraceBegin(void);
+
+void   UT_TraceEnd(void);
+
 void   UT_Quit(void);
 
 #endif